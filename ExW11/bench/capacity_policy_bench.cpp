@@ -0,0 +1,67 @@
+/*
+ * Per-element cost of the modulo versus the bit mask index mapping.
+ * The queues are driven from a single thread; BoundedQueue uses a no-op mutex and
+ * condition variable so that the index arithmetic is not hidden behind the lock.
+ *
+ * g++ -std=c++20 -O2 -I../src capacity_policy_bench.cpp -o capacity_policy_bench
+ */
+
+#include "BoundedQueue.h"
+#include "SPSCQueue.h"
+
+#include <chrono>
+#include <cstdio>
+
+struct NoMutex {
+	void lock() {}
+	void unlock() {}
+	bool try_lock() { return true; }
+};
+
+struct NoConditionVariable {
+	template<typename LOCK, typename COND>
+	void wait(LOCK &, COND) {}
+	template<typename LOCK, typename COND, typename REP, typename PER>
+	bool wait_for(LOCK &, std::chrono::duration<REP, PER> const &, COND cond) { return cond(); }
+	void notify_one() {}
+	void notify_all() {}
+};
+
+template<typename Queue>
+double nanosPerElement(unsigned const capacity, unsigned const rounds) {
+	Queue queue{capacity};
+	unsigned long long sum{0};
+	auto const start = std::chrono::steady_clock::now();
+	for (unsigned round = 0; round < rounds; ++round) {
+		for (unsigned i = 0; i < capacity / 2; ++i) queue.push(i);
+		for (unsigned i = 0; i < capacity / 2; ++i) sum += queue.pop();
+	}
+	auto const elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start);
+	if (sum == 42) std::puts("");
+	return elapsed.count() / (2.0 * rounds * (capacity / 2));
+}
+
+template<template<typename> class Queue>
+void compare(char const * name, unsigned const capacity, unsigned const rounds) {
+	auto const modulo = nanosPerElement<Queue<ModuloCapacity>>(capacity, rounds);
+	auto const mask = nanosPerElement<Queue<ExactPowerOfTwoCapacity>>(capacity, rounds);
+	std::printf("%-14s capacity %6u: modulo %6.2f ns/op, mask %6.2f ns/op, speedup %4.2fx\n",
+			name, capacity, modulo, mask, modulo / mask);
+}
+
+template<typename Policy>
+using UnlockedBoundedQueue = BoundedQueue<unsigned, NoMutex, NoConditionVariable, Policy>;
+template<typename Policy>
+using LockedBoundedQueue = BoundedQueue<unsigned, std::mutex, std::condition_variable, Policy>;
+template<typename Policy>
+using SPSC = SPSCQueue<unsigned, Policy>;
+
+int main() {
+	for (unsigned capacity : {64u, 1024u, 65536u}) {
+		auto const rounds = (1u << 24) / capacity;
+		compare<UnlockedBoundedQueue>("BoundedQueue*", capacity, rounds);
+		compare<LockedBoundedQueue>("BoundedQueue", capacity, rounds);
+		compare<SPSC>("SPSCQueue", capacity, rounds);
+	}
+	std::puts("* with no-op mutex and condition variable");
+}
@@ -0,0 +1,97 @@
+/*
+ * A full BoundedQueue of 64 byte elements is rotated (pop one, push it back) until every slot was visited
+ * a few times, once on the default allocator and once on HugePageAllocator. Reports the time per
+ * operation, the minor page faults and, where perf_event_open is permitted, the dTLB misses of the run.
+ * The first rotation pays the page faults, the following ones show the steady state.
+ *
+ * g++ -std=c++20 -O2 -pthread -I../src huge_page_bench.cpp -o huge_page_bench
+ */
+
+#include "BoundedQueue.h"
+#include "HugePageAllocator.h"
+
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+using Element = std::array<std::uint64_t, 8>;
+template<typename Allocator>
+using Queue = BoundedQueue<Element, std::mutex, std::condition_variable, ModuloCapacity, Allocator>;
+
+constexpr unsigned rotations{4};
+
+struct TlbMisses {
+	TlbMisses() {
+		perf_event_attr attr{};
+		attr.size = sizeof(attr);
+		attr.type = PERF_TYPE_HW_CACHE;
+		attr.config = PERF_COUNT_HW_CACHE_DTLB | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+		attr.disabled = 1;
+		attr.exclude_kernel = 1;
+		attr.exclude_hv = 1;
+		fd_ = static_cast<int>(::syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+	}
+	~TlbMisses() { if (fd_ >= 0) ::close(fd_); }
+
+	void start() {
+		if (fd_ < 0) return;
+		::ioctl(fd_, PERF_EVENT_IOC_RESET, 0);
+		::ioctl(fd_, PERF_EVENT_IOC_ENABLE, 0);
+	}
+	// -1 if the counter is not available
+	long long stop() {
+		if (fd_ < 0) return -1;
+		::ioctl(fd_, PERF_EVENT_IOC_DISABLE, 0);
+		long long misses{};
+		return ::read(fd_, &misses, sizeof(misses)) == sizeof(misses) ? misses : -1;
+	}
+
+private:
+	int fd_{-1};
+};
+
+long minorFaults() {
+	rusage usage{};
+	::getrusage(RUSAGE_SELF, &usage);
+	return usage.ru_minflt;
+}
+
+template<typename Allocator>
+void measure(char const * name, std::size_t const capacity, Allocator const & allocator) {
+	Queue<Allocator> queue{capacity, allocator};
+	TlbMisses tlb{};
+	auto const faults = minorFaults();
+	tlb.start();
+	auto const start = std::chrono::steady_clock::now();
+
+	for (std::size_t i = 0; i < capacity; ++i) queue.push(Element{i});
+	for (unsigned r = 0; r < rotations; ++r) {
+		for (std::size_t i = 0; i < capacity; ++i) queue.push(queue.pop());
+	}
+
+	auto const elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start);
+	auto const misses = tlb.stop();
+	auto const ops = capacity * (1 + 2 * rotations);
+	std::printf("%-10s %9zu elements %5zu MiB: %6.2f ns/op %8ld faults", name, capacity, capacity * sizeof(Element) >> 20,
+			elapsed.count() / ops, minorFaults() - faults);
+	if (misses >= 0) std::printf(" %12lld dTLB misses\n", misses);
+	else std::printf("  dTLB misses n/a\n");
+}
+
+int main() {
+	for (std::size_t capacity : {std::size_t{1} << 16, std::size_t{1} << 20, std::size_t{1} << 22}) {
+		measure("default", capacity, std::allocator<Element>{});
+		measure("huge page", capacity, HugePageAllocator<Element>{});
+		measure("prefault", capacity, HugePageAllocator<Element>{HugePagePlacement::prefault});
+	}
+}
@@ -0,0 +1,129 @@
+/*
+ * Round trip latency between two pinned threads: the main thread pushes a token into ping, the echo thread
+ * pops it and pushes it into pong, the main thread pops it again. Every round trip goes into a log-linear
+ * histogram (32 linear buckets per power of two, so every bucket is at most ~3% wide) and the percentiles are
+ * read from it. Any queue with blocking push/pop and a capacity constructor can be measured; for BoundedQueue
+ * and TwoLockQueue the mutex and condition variable types are template parameters of the measurement.
+ * The threads are pinned to CPU 0 and 1; on a single CPU both share it and every hand-off is a context switch.
+ *
+ * g++ -std=c++20 -O2 -pthread -I../src latency_bench.cpp -o latency_bench
+ */
+
+#include "BoundedQueue.h"
+#include "FifoConditionVariable.h"
+#include "MPMCQueue.h"
+#include "SPSCQueue.h"
+#include "SpinParkConditionVariable.h"
+#include "TwoLockQueue.h"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <thread>
+
+#include <pthread.h>
+#include <sched.h>
+
+using Clock = std::chrono::steady_clock;
+
+constexpr unsigned warmup{10000};
+constexpr unsigned samples{200000};
+constexpr unsigned stop{~0u};
+
+struct LatencyHistogram {
+	static constexpr unsigned sub_bucket_bits{5};
+	static constexpr unsigned sub_buckets{1u << sub_bucket_bits};
+	static constexpr unsigned ranges{64 - sub_bucket_bits + 1};
+
+	void record(std::uint64_t const ns) noexcept {
+		++counts_[_bucket(ns)];
+		++total_;
+		max_ = std::max(max_, ns);
+	}
+	// upper bound of the bucket holding the given quantile
+	std::uint64_t percentile(double const quantile) const noexcept {
+		auto const rank = static_cast<std::uint64_t>(quantile * total_);
+		std::uint64_t seen{0};
+		for (unsigned bucket{0}; bucket < counts_.size(); ++bucket) {
+			seen += counts_[bucket];
+			if (seen > rank) return std::min(_upperBound(bucket), max_);
+		}
+		return max_;
+	}
+	std::uint64_t max() const noexcept { return max_; }
+
+private:
+	std::array<std::uint64_t, ranges * sub_buckets> counts_{};
+	std::uint64_t total_{0};
+	std::uint64_t max_{0};
+
+	// values below sub_buckets are exact, above that every power of two range is split into sub_buckets linear buckets
+	static unsigned _bucket(std::uint64_t const ns) noexcept {
+		if (ns < sub_buckets) return static_cast<unsigned>(ns);
+		unsigned const range = std::bit_width(ns) - sub_bucket_bits;
+		return range * sub_buckets + static_cast<unsigned>((ns >> (range - 1)) - sub_buckets);
+	}
+	static std::uint64_t _upperBound(unsigned const bucket) noexcept {
+		if (bucket < sub_buckets) return bucket;
+		unsigned const range = bucket / sub_buckets;
+		return ((std::uint64_t{bucket % sub_buckets} + sub_buckets + 1) << (range - 1)) - 1;
+	}
+};
+
+void pinTo(unsigned const cpu) {
+	cpu_set_t set{};
+	CPU_ZERO(&set);
+	CPU_SET(cpu % std::max(1u, std::thread::hardware_concurrency()), &set);
+	pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+}
+
+template<typename Queue>
+void measure(char const * name) {
+	Queue ping{1}, pong{1};
+	std::thread echo{[&]{
+		pinTo(1);
+		for (unsigned token = ping.pop(); token != stop; token = ping.pop()) pong.push(token);
+	}};
+	pinTo(0);
+
+	LatencyHistogram histogram{};
+	for (unsigned i = 0; i < warmup + samples; ++i) {
+		auto const start = Clock::now();
+		ping.push(i);
+		pong.pop();
+		auto const ns = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count();
+		if (i >= warmup) histogram.record(static_cast<std::uint64_t>(ns));
+	}
+	ping.push(stop);
+	echo.join();
+
+	std::printf("%-44s p50 %8llu  p99 %8llu  p99.9 %8llu  max %9llu ns\n", name,
+			static_cast<unsigned long long>(histogram.percentile(0.5)),
+			static_cast<unsigned long long>(histogram.percentile(0.99)),
+			static_cast<unsigned long long>(histogram.percentile(0.999)),
+			static_cast<unsigned long long>(histogram.max()));
+}
+
+template<typename M, typename CV>
+void measureLocking(char const * mutex, char const * cv) {
+	char name[64];
+	std::snprintf(name, sizeof(name), "BoundedQueue<%s, %s>", mutex, cv);
+	measure<BoundedQueue<unsigned, M, CV>>(name);
+	std::snprintf(name, sizeof(name), "TwoLockQueue<%s, %s>", mutex, cv);
+	measure<TwoLockQueue<unsigned, M, CV>>(name);
+}
+
+int main() {
+	measureLocking<std::mutex, std::condition_variable>("mutex", "condition_variable");
+	measureLocking<std::mutex, std::condition_variable_any>("mutex", "condition_variable_any");
+	measureLocking<std::mutex, SpinParkConditionVariable<>>("mutex", "SpinParkCV");
+	measureLocking<std::mutex, FifoConditionVariable>("mutex", "FifoCV");
+	measure<SPSCQueue<unsigned>>("SPSCQueue");
+	measure<MPMCQueue<unsigned>>("MPMCQueue");
+	std::printf("%u hardware threads\n", std::thread::hardware_concurrency());
+}
@@ -0,0 +1,47 @@
+/*
+ * Throughput of the ten producer/ten consumer scenario, one BoundedQueue versus a
+ * ShardedQueue with an increasing number of lanes. The aggregate capacity is the same
+ * for all runs, so only the lock contention differs.
+ * The numbers only say something about scaling on a machine with at least producers + consumers
+ * hardware threads. With fewer, the threads take turns on the cores and every extra lane is pure overhead.
+ *
+ * g++ -std=c++20 -O2 -pthread -I../src sharded_queue_bench.cpp -o sharded_queue_bench
+ */
+
+#include "BoundedQueue.h"
+#include "ShardedQueue.h"
+
+#include <chrono>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+constexpr unsigned producers{10};
+constexpr unsigned consumers{10};
+constexpr unsigned perThread{200000};
+constexpr unsigned capacity{1024};
+
+template<typename Queue>
+double millionOpsPerSecond(Queue & queue) {
+	std::vector<std::thread> threads{};
+	auto const start = std::chrono::steady_clock::now();
+	for (unsigned p = 0; p < producers; ++p) {
+		threads.emplace_back([&]{ for (unsigned i = 0; i < perThread; ++i) queue.push(i); });
+	}
+	for (unsigned c = 0; c < consumers; ++c) {
+		threads.emplace_back([&]{ for (unsigned i = 0; i < perThread; ++i) queue.pop(); });
+	}
+	for (auto & thread : threads) thread.join();
+	auto const elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start);
+	return producers * perThread / elapsed.count() / 1e6;
+}
+
+int main() {
+	BoundedQueue<unsigned> single{capacity};
+	std::printf("BoundedQueue          : %6.2f Mops/s\n", millionOpsPerSecond(single));
+	for (unsigned lanes : {1u, 2u, 4u, 8u, 16u}) {
+		ShardedQueue<unsigned> sharded{capacity, lanes};
+		std::printf("ShardedQueue %2u lanes : %6.2f Mops/s\n", lanes, millionOpsPerSecond(sharded));
+	}
+	std::printf("%u hardware threads\n", std::thread::hardware_concurrency());
+}
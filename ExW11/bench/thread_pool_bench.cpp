@@ -0,0 +1,60 @@
+/*
+ * Throughput of small tasks: ThreadPool::post, ThreadPool::submit and std::async.
+ * post only costs the queue operation, submit adds the packaged_task/future shared state,
+ * std::async starts a thread per task (libstdc++) on top of that.
+ *
+ * g++ -std=c++20 -O2 -pthread -I../src thread_pool_bench.cpp -o thread_pool_bench
+ */
+
+#include "ThreadPool.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <future>
+#include <vector>
+
+constexpr unsigned tasks{100000};
+constexpr unsigned inFlight{256};
+
+template<typename Run>
+double thousandTasksPerSecond(Run run) {
+	auto const start = std::chrono::steady_clock::now();
+	run();
+	auto const elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start);
+	return tasks / elapsed.count() / 1e3;
+}
+
+int main() {
+	std::atomic<unsigned long> sum{0};
+	auto const threads = ThreadPool<>::defaultThreads();
+
+	auto const posted = thousandTasksPerSecond([&]{
+		ThreadPool<> pool{threads, 1024};
+		for (unsigned i = 0; i < tasks; ++i) pool.post([&sum, i]{ sum += i; });
+	});
+	auto const submitted = thousandTasksPerSecond([&]{
+		ThreadPool<> pool{threads, 1024};
+		std::vector<std::future<unsigned>> results{};
+		results.reserve(tasks);
+		for (unsigned i = 0; i < tasks; ++i) results.push_back(pool.submit([i]{ return i; }));
+		for (auto & result : results) sum += result.get();
+	});
+	auto const async = thousandTasksPerSecond([&]{
+		// every std::async task is a thread, keep at most inFlight of them alive
+		std::vector<std::future<unsigned>> results{};
+		for (unsigned i = 0; i < tasks; ++i) {
+			results.push_back(std::async(std::launch::async, [i]{ return i; }));
+			if (results.size() == inFlight) {
+				for (auto & result : results) sum += result.get();
+				results.clear();
+			}
+		}
+		for (auto & result : results) sum += result.get();
+	});
+
+	std::printf("ThreadPool::post   : %8.1f k tasks/s\n", posted);
+	std::printf("ThreadPool::submit : %8.1f k tasks/s\n", submitted);
+	std::printf("std::async         : %8.1f k tasks/s\n", async);
+	std::printf("%u workers, checksum %lu\n", unsigned(threads), sum.load());
+}
@@ -0,0 +1,105 @@
+/*
+ * Throughput sweep over every multi-producer/multi-consumer queue in ../src, printed as CSV for plotting:
+ * producers and consumers from 1 to hardware_concurrency (powers of two), capacities from 1 to 64Ki
+ * and element sizes from 4 B to 4 KiB. SPSCQueue only runs the 1/1 configuration.
+ * Every run moves the same number of elements; ops_per_sec counts pushed elements per wall clock second,
+ * cpu_ns_per_op is the process CPU time (user + system, all threads) per element, which also shows
+ * how much of the time is spent spinning.
+ *
+ * g++ -std=c++20 -O2 -pthread -I../src throughput_bench.cpp -o throughput_bench
+ * ./throughput_bench [elements per run] > throughput.csv
+ */
+
+#include "BoundedPriorityQueue.h"
+#include "BoundedQueue.h"
+#include "MPMCQueue.h"
+#include "SPSCQueue.h"
+#include "ShardedQueue.h"
+#include "TwoLockQueue.h"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+#include <sys/resource.h>
+
+template<std::size_t Bytes>
+struct Payload {
+	Payload() = default;
+	explicit Payload(unsigned value) { bytes[0] = static_cast<unsigned char>(value); }
+	bool operator<(Payload const & rhs) const noexcept { return bytes[0] < rhs.bytes[0]; }
+
+	std::array<unsigned char, Bytes> bytes{};
+};
+
+double cpuSeconds() {
+	rusage usage{};
+	::getrusage(RUSAGE_SELF, &usage);
+	auto const seconds = [](timeval const & tv){ return tv.tv_sec + tv.tv_usec / 1e6; };
+	return seconds(usage.ru_utime) + seconds(usage.ru_stime);
+}
+
+// splits total into parts that differ by at most one
+unsigned share(unsigned const total, unsigned const parts, unsigned const part) {
+	return total / parts + (part < total % parts);
+}
+
+template<typename Queue>
+void run(char const * name, unsigned const producers, unsigned const consumers, std::size_t const capacity, unsigned const elements) {
+	using Element = typename Queue::value_type;
+	Queue queue{capacity};
+	std::vector<std::thread> threads{};
+
+	auto const cpuStart = cpuSeconds();
+	auto const start = std::chrono::steady_clock::now();
+	for (unsigned p = 0; p < producers; ++p) {
+		threads.emplace_back([&, p]{
+			for (unsigned i = share(elements, producers, p); i; --i) queue.push(Element{i});
+		});
+	}
+	for (unsigned c = 0; c < consumers; ++c) {
+		threads.emplace_back([&, c]{
+			for (unsigned i = share(elements, consumers, c); i; --i) queue.pop();
+		});
+	}
+	for (auto & thread : threads) thread.join();
+	auto const seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	auto const cpu = cpuSeconds() - cpuStart;
+
+	std::printf("%s,%u,%u,%zu,%zu,%u,%.6f,%.0f,%.1f\n", name, producers, consumers, capacity, sizeof(Element),
+			elements, seconds, elements / seconds, cpu * 1e9 / elements);
+	std::fflush(stdout);
+}
+
+template<std::size_t Bytes>
+void sweep(std::vector<unsigned> const & threads, unsigned const elements) {
+	using Element = Payload<Bytes>;
+	for (std::size_t capacity : {std::size_t{1}, std::size_t{16}, std::size_t{1024}, std::size_t{65536}}) {
+		for (unsigned producers : threads) {
+			for (unsigned consumers : threads) {
+				run<BoundedQueue<Element>>("BoundedQueue", producers, consumers, capacity, elements);
+				run<TwoLockQueue<Element>>("TwoLockQueue", producers, consumers, capacity, elements);
+				run<ShardedQueue<Element>>("ShardedQueue", producers, consumers, capacity, elements);
+				run<MPMCQueue<Element>>("MPMCQueue", producers, consumers, capacity, elements);
+				run<BoundedPriorityQueue<Element>>("BoundedPriorityQueue", producers, consumers, capacity, elements);
+				if (producers == 1 && consumers == 1) run<SPSCQueue<Element>>("SPSCQueue", 1, 1, capacity, elements);
+			}
+		}
+	}
+}
+
+int main(int argc, char const * argv[]) {
+	unsigned const elements = argc > 1 ? static_cast<unsigned>(std::strtoul(argv[1], nullptr, 10)) : 100000;
+	std::vector<unsigned> threads{};
+	for (unsigned n = 1; n <= std::max(1u, std::thread::hardware_concurrency()); n *= 2) threads.push_back(n);
+
+	std::printf("queue,producers,consumers,capacity,element_bytes,elements,seconds,ops_per_sec,cpu_ns_per_op\n");
+	sweep<4>(threads, elements);
+	sweep<64>(threads, elements);
+	sweep<512>(threads, elements);
+	sweep<4096>(threads, elements);
+}
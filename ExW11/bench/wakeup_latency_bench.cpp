@@ -0,0 +1,57 @@
+/*
+ * Wakeup latency of a consumer blocked in BoundedQueue::pop(), std::condition_variable
+ * versus SpinParkConditionVariable. The producer pushes a timestamp after a pause;
+ * short pauses stay within the spin window, long pauses force the consumer to park.
+ *
+ * g++ -std=c++20 -O2 -pthread -I../src wakeup_latency_bench.cpp -o wakeup_latency_bench
+ */
+
+#include "BoundedQueue.h"
+#include "SpinParkConditionVariable.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+using Clock = std::chrono::steady_clock;
+
+void busyWait(std::chrono::nanoseconds const pause) {
+	auto const until = Clock::now() + pause;
+	while (Clock::now() < until) { }
+}
+
+template<typename CV>
+void measure(char const * name, std::chrono::nanoseconds const pause, unsigned const samples) {
+	BoundedQueue<Clock::time_point, std::mutex, CV> queue{1};
+	std::vector<double> latencies{};
+	latencies.reserve(samples);
+
+	std::thread consumer{[&]{
+		for (unsigned i = 0; i < samples; ++i) {
+			auto const sent = queue.pop();
+			latencies.push_back(std::chrono::duration<double, std::micro>(Clock::now() - sent).count());
+		}
+	}};
+	for (unsigned i = 0; i < samples; ++i) {
+		busyWait(pause);
+		queue.push(Clock::now());
+	}
+	consumer.join();
+
+	std::sort(std::begin(latencies), std::end(latencies));
+	std::printf("%-32s pause %7.1f us: p50 %7.2f us, p99 %7.2f us, max %8.2f us\n", name,
+			std::chrono::duration<double, std::micro>(pause).count(),
+			latencies[samples / 2], latencies[samples * 99 / 100], latencies.back());
+}
+
+int main() {
+	using namespace std::chrono_literals;
+	for (auto pause : {2000ns, 10000ns, 200000ns}) {
+		auto const samples = pause < 100000ns ? 20000u : 2000u;
+		measure<std::condition_variable>("std::condition_variable", pause, samples);
+		measure<SpinParkConditionVariable<>>("SpinParkConditionVariable<20>", pause, samples);
+		measure<SpinParkConditionVariable<500>>("SpinParkConditionVariable<500>", pause, samples);
+	}
+}
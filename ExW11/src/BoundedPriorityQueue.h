@@ -0,0 +1,200 @@
+#ifndef SRC_BOUNDEDPRIORITYQUEUE_H_
+#define SRC_BOUNDEDPRIORITYQUEUE_H_
+
+/*
+ * Blocking bounded priority queue with the push/pop surface of BoundedQueue.
+ * pop() returns the greatest element according to Compare, like std::priority_queue;
+ * use std::greater to get the smallest one first. Elements of equal priority are not kept in FIFO order.
+ * The binary heap lives in the same raw uninitialized storage as the BoundedQueue ring:
+ * an element is constructed behind the last one and sifted up, the top is moved out after
+ * std::pop_heap swapped it to the end. Both sift in O(log n) and only move elements.
+ * Waiting, waiter counting and close() share WaitingSide with BoundedQueue.
+ * Compare must not throw: a comparison failing in the middle of a sift leaves the heap order unspecified.
+ * The element being pushed is only counted once push_heap succeeded.
+ */
+
+#include "BoundedQueue.h"
+#include "SlotStorage.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <utility>
+
+template <typename T, typename Compare=std::less<T>, typename M=std::mutex, typename CV=std::condition_variable>
+struct BoundedPriorityQueue {
+	using guard = std::lock_guard<M>;
+	using lock = std::unique_lock<M>;
+
+	using value_type = T;
+	using reference = value_type &;
+	using const_reference = value_type const &;
+	using size_type = size_t;
+	using value_compare = Compare;
+	using memory_type = SlotStorage<value_type>;
+
+	explicit BoundedPriorityQueue(size_type capacity, Compare const & compare = Compare{}) :
+			capacity_{capacity}, container_{capacity_}, compare_{compare} {
+		if (!capacity) throw std::invalid_argument{"capacity must be > 0"};
+	}
+
+	~BoundedPriorityQueue() { std::destroy(elements(), elements() + size_); }
+
+	BoundedPriorityQueue(BoundedPriorityQueue const &) = delete;
+	BoundedPriorityQueue & operator=(BoundedPriorityQueue const &) = delete;
+
+	bool empty() const noexcept { return !size(); }
+	bool full() const noexcept { return size() >= capacity_; }
+	size_type size() const noexcept { return sizeSnapshot_.load(std::memory_order_relaxed); }
+	size_type capacity() const noexcept { return capacity_; }
+	bool is_closed() const noexcept { return closedSnapshot_.load(std::memory_order_acquire); }
+
+	void close() {
+		guard lk{mx_};
+		if (closed_) return;
+
+		closed_ = true;
+		_publishClosed();
+		consumers_.signal_all();
+		producers_.signal_all();
+	}
+
+	void push(value_type const & ele) { emplace(ele); }
+	void push(value_type && ele) { emplace(std::move(ele)); }
+	bool try_push(value_type const & ele) { return try_emplace(ele); }
+	bool try_push(value_type && ele) { return try_emplace(std::move(ele)); }
+	template<class Rep, class Period>
+	bool try_push_for(T const & ele, std::chrono::duration<Rep, Period> const & timeout) {
+		return try_emplace_for(timeout, ele);
+	}
+	template<class Rep, class Period>
+	bool try_push_for(T && ele, std::chrono::duration<Rep, Period> const & timeout) {
+		return try_emplace_for(timeout, std::move(ele));
+	}
+
+	template<typename... Args>
+	void emplace(Args &&... args) {
+		lock lk{mx_};
+		_waitNotFull(lk);
+
+		_emplaceNotify(std::forward<Args>(args)...);
+	}
+	template<typename... Args>
+	bool try_emplace(Args &&... args) {
+		guard lk{mx_};
+		if (closed_ || _full()) return false;
+
+		_emplaceNotify(std::forward<Args>(args)...);
+		return true;
+	}
+	template<class Rep, class Period, typename... Args>
+	bool try_emplace_for(std::chrono::duration<Rep, Period> const & timeout, Args &&... args) {
+		lock lk{mx_};
+		if (_waitNotFullFor(lk, timeout)) {
+			_emplaceNotify(std::forward<Args>(args)...);
+			return true;
+		}
+		return false;
+	}
+
+	value_type pop() {
+		lock lk{mx_};
+		_waitNotEmpty(lk);
+
+		return _takeNotify();
+	}
+	bool try_pop(value_type & ele) {
+		guard lk{mx_};
+		if (_empty()) return false;
+
+		ele = _takeNotify();
+		return true;
+	}
+	template<class Rep, class Period>
+	bool try_pop_for(value_type & ele, std::chrono::duration<Rep,Period> const & timeout) {
+		lock lk{mx_};
+		if (_waitNotEmptyFor(lk, timeout)) {
+			ele = _takeNotify();
+			return true;
+		}
+		return false;
+	}
+	std::optional<value_type> try_pop() {
+		guard lk{mx_};
+		if (_empty()) return std::nullopt;
+
+		return _takeNotify();
+	}
+	template<class Rep, class Period>
+	std::optional<value_type> try_pop_for(std::chrono::duration<Rep,Period> const & timeout) {
+		lock lk{mx_};
+		if (!_waitNotEmptyFor(lk, timeout)) return std::nullopt;
+
+		return _takeNotify();
+	}
+
+private:
+	mutable M mx_{};
+	// threads blocked until the queue is not full/not empty
+	WaitingSide<CV> producers_{};
+	WaitingSide<CV> consumers_{};
+
+	size_type size_{0};
+	size_type const capacity_;
+	memory_type const container_;
+	[[no_unique_address]] Compare compare_;
+	bool closed_{false};
+
+	// lock-free mirrors of size_ and closed_, only written with mx_ held
+	std::atomic<size_type> sizeSnapshot_{0};
+	std::atomic<bool> closedSnapshot_{false};
+
+	bool _empty() const noexcept { return !size_; }
+	bool _full() const noexcept { return size_ == capacity_; }
+	void _publishSize() noexcept { sizeSnapshot_.store(size_, std::memory_order_relaxed); }
+	void _publishClosed() noexcept { closedSnapshot_.store(closed_, std::memory_order_release); }
+
+	template<typename... Args>
+	void _emplaceNotify(Args &&... args) {
+		::new(elements() + size_) value_type(std::forward<Args>(args)...);
+		try {
+			std::push_heap(elements(), elements() + size_ + 1, std::ref(compare_));
+		} catch (...) {
+			elements()[size_].~value_type();
+			throw;
+		}
+		++size_;
+		_publishSize();
+		consumers_.signal();
+	}
+	value_type _takeNotify() {
+		std::pop_heap(elements(), elements() + size_, std::ref(compare_));
+		--size_;
+		value_type top = std::move(elements()[size_]);
+		elements()[size_].~value_type();
+		_publishSize();
+		producers_.signal();
+		return top;
+	}
+
+	void _waitNotFull(lock & lk) { producers_.wait(lk, closed_, [this]{ return !closed_ && !_full(); }); }
+	template<class Rep, class Period>
+	bool _waitNotFullFor(lock & lk, std::chrono::duration<Rep, Period> const & timeout) {
+		return producers_.wait_for(lk, timeout, closed_, [this]{ return !closed_ && !_full(); });
+	}
+	void _waitNotEmpty(lock & lk) { consumers_.wait(lk, closed_, [this]{ return !_empty(); }); }
+	template<class Rep, class Period>
+	bool _waitNotEmptyFor(lock & lk, std::chrono::duration<Rep, Period> const & timeout) {
+		return consumers_.wait_for(lk, timeout, closed_, [this]{ return !_empty(); });
+	}
+
+	value_type * elements() const { return container_.get(); }
+};
+
+#endif /* SRC_BOUNDEDPRIORITYQUEUE_H_ */
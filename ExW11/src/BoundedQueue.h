@@ -13,16 +13,115 @@
  * 3. Why is pop() returning a value by value and not void as in BoundedBuffer?
  * Violates "command-query separation", but both steps need to be done "atomically".
  * If command and query is separated, the caller has to lock the queue.
+ *
+ * close() ends the stream: every blocked thread wakes up, pushes fail from then on
+ * (push/emplace throw closed_queue, the try_ variants return false) and pops drain the
+ * remaining elements before pop()/pop_bulk()/pop_batch() throw closed_queue and the try_ variants give up at once.
+ *
+ * size(), empty(), full(), capacity() and is_closed() do not lock: they read atomic mirrors that are
+ * updated under the lock whenever the ring or the closed flag changes. The result is a snapshot that may be stale by the
+ * time the caller looks at it, which is all a poll from another thread can get anyway.
+ *
+ * subscribe() registers a WaitSignal that is notified on every push and on close(),
+ * which lets a Selector block on several queues at once.
+ *
+ * co_push()/co_pop() suspend the calling coroutine instead of the thread. Suspended coroutines wait in
+ * intrusive FIFO lists (the awaiter objects live in the coroutine frames, nothing is allocated):
+ * a push hands its element directly to the first waiting co_pop, a pop admits the element of the first
+ * waiting co_push. After the queue is unlocked the coroutine is handed to executor.try_post() if the executor
+ * has one, otherwise to executor.post(). If the executor refuses or throws, the coroutine resumes on the calling
+ * thread, so a full or shut down executor neither blocks the queue operation nor loses the coroutine.
+ * A suspended coroutine must not be destroyed before it is resumed.
+ *
+ * The ring is obtained from Allocator through std::allocator_traits, so it is aligned for T
+ * (also for over-aligned types) and can live in an arena: pmr::BoundedQueue takes a std::pmr::memory_resource.
+ * The allocator follows the rules of the standard containers: copies ask select_on_container_copy_construction,
+ * a moved-to queue keeps the allocator of its source, and assignment and swap only hand over the allocator
+ * if it propagates. Move assignment between unequal non-propagating allocators moves the elements one by one,
+ * swap() requires equal allocators in that case.
+ *
+ * FairBoundedQueue serves blocked producers, and separately blocked consumers, strictly in arrival order
+ * (see FifoConditionVariable). The non-blocking try_ operations do not line up and may still take
+ * a slot or an element while others wait.
  */
 
+#include "CapacityPolicy.h"
+#include "FifoConditionVariable.h"
+#include "WaitSignal.h"
+
+#include <algorithm>
+#include <atomic>
 #include <condition_variable>
 #include <chrono>
+#include <concepts>
+#include <coroutine>
 #include <memory>
+#include <memory_resource>
 #include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <type_traits>
 #include <utility>
+#include <vector>
+
+struct closed_queue : std::runtime_error {
+	closed_queue() : std::runtime_error{"queue is closed"} {}
+};
+
+/*
+ * One side (producers or consumers) of a blocking queue: the condition variable its threads wait on
+ * and how many of them do, so a signal is skipped when nobody waits. Every member requires the queue's lock.
+ * A closed queue ends every wait. A wait succeeds if ready() holds, otherwise wait() throws closed_queue
+ * and the timed waits return false. Producers pass !closed && !full, consumers !empty, so they drain a closed queue.
+ */
+template <typename CV>
+struct WaitingSide {
+	using size_type = size_t;
+
+	template<typename LOCK, typename Ready>
+	void wait(LOCK & lk, bool const & closed, Ready ready) {
+		{
+			Waiting waiting{waiters};
+			cv.wait(lk, [&]{ return closed || ready(); });
+		}
+		if (!ready()) throw closed_queue{};
+	}
+	template<typename LOCK, class Rep, class Period, typename Ready>
+	bool wait_for(LOCK & lk, std::chrono::duration<Rep, Period> const & timeout, bool const & closed, Ready ready) {
+		Waiting waiting{waiters};
+		return cv.wait_for(lk, timeout, [&]{ return closed || ready(); }) && ready();
+	}
+	template<typename LOCK, class Clock, class Duration, typename Ready>
+	bool wait_until(LOCK & lk, std::chrono::time_point<Clock, Duration> const & deadline, bool const & closed, Ready ready) {
+		Waiting waiting{waiters};
+		return cv.wait_until(lk, deadline, [&]{ return closed || ready(); }) && ready();
+	}
+
+	// wakes the waiters for n new elements or free slots, a single notify_one() if one waiter is enough
+	void signal(size_type const n = 1) {
+		if (!waiters || !n) return;
+		if (n == 1 || waiters == 1) cv.notify_one();
+		else cv.notify_all();
+	}
+	void signal_all() { cv.notify_all(); }
+
+	CV cv{};
+	size_type waiters{0};
+
+private:
+	struct Waiting {
+		explicit Waiting(size_type & waiters) : waiters_{waiters} { ++waiters_; }
+		~Waiting() { --waiters_; }
+		size_type & waiters_;
+	};
+};
 
-template <typename T, typename M=std::mutex, typename CV=std::condition_variable>
+template <typename T, typename M=std::mutex, typename CV=std::condition_variable, typename CapacityPolicy=ModuloCapacity, typename Allocator=std::allocator<T>>
 struct BoundedQueue {
+	using alloc_traits = std::allocator_traits<Allocator>;
+	static_assert(std::is_same<typename alloc_traits::value_type, T>::value, "Allocator::value_type must be T");
+	static_assert(std::is_same<typename alloc_traits::pointer, T *>::value, "fancy pointers are not supported");
+
 	using guard = std::lock_guard<M>;
 	using lock = std::unique_lock<M>;
 
@@ -30,95 +129,293 @@ struct BoundedQueue {
 	using reference = value_type &;
 	using const_reference = value_type const &;
 	using size_type = size_t;
-	using memory_type = std::unique_ptr<char[]>;
+	using allocator_type = Allocator;
 
-	explicit BoundedQueue(size_type capacity) : capacity_{capacity}, container_{newMemory()} {
+	explicit BoundedQueue(size_type capacity, allocator_type const & allocator = allocator_type{}) :
+			capacity_{CapacityPolicy::capacity(capacity)}, container_{allocator, capacity_} {
 		if (!capacity) throw std::invalid_argument{"capacity must be > 0"};
+		_publishCapacity();
 	}
 
 	~BoundedQueue() { while (!_empty()) _pop(); }
 
-	BoundedQueue(BoundedQueue const & rhs) : capacity_{rhs.capacity_}, container_{newMemory()} {
+	BoundedQueue(BoundedQueue const & rhs) :
+			BoundedQueue{rhs, alloc_traits::select_on_container_copy_construction(rhs.get_allocator())} {}
+	BoundedQueue(BoundedQueue const & rhs, allocator_type const & allocator) : capacity_{rhs.capacity_}, container_{allocator, capacity_} {
+		_publishCapacity();
+		guard lk{rhs.mx_};
+		closed_ = rhs.closed_;
+		_publishClosed();
+		for (size_type i{0}; i < rhs._size(); ++i) _emplace(rhs._at(i));
+	}
+	BoundedQueue(BoundedQueue && rhs) : BoundedQueue{rhs.capacity_, rhs.get_allocator()} { swap(rhs); }
+	// steals the ring if the allocators are equal, otherwise moves the elements over
+	BoundedQueue(BoundedQueue && rhs, allocator_type const & allocator) : BoundedQueue{rhs.capacity_, allocator} {
+		if (allocator == rhs.get_allocator()) {
+			swap(rhs);
+			return;
+		}
 		guard lk{rhs.mx_};
-		for (size_type i{0}; i < rhs._size(); ++i) _push(rhs._at(i));
+		closed_ = rhs.closed_;
+		_publishClosed();
+		for (; !rhs._empty(); rhs._pop()) _emplace(std::move(rhs._at(0)));
+		rhs._publishSize();
 	}
-	BoundedQueue(BoundedQueue && rhs) : BoundedQueue{rhs.capacity_} { swap(rhs); }
 
 	BoundedQueue & operator=(BoundedQueue const & rhs) {
 		if (&rhs == this) return *this;
 
-		auto tmp{rhs};
-		swap(tmp);
+		constexpr bool propagate{alloc_traits::propagate_on_container_copy_assignment::value};
+		BoundedQueue tmp{rhs, propagate ? rhs.get_allocator() : get_allocator()};
+		_swap<propagate>(tmp);
 		return *this;
 	}
 	BoundedQueue & operator=(BoundedQueue && rhs) {
 		if (&rhs == this) return *this;
 
-		swap(rhs);
+		constexpr bool propagate{alloc_traits::propagate_on_container_move_assignment::value};
+		if (propagate || get_allocator() == rhs.get_allocator()) {
+			_swap<propagate>(rhs);
+		} else {
+			BoundedQueue tmp{std::move(rhs), get_allocator()};
+			_swap<false>(tmp);
+		}
 		return *this;
 	}
 
-	bool empty() const noexcept { guard lk{mx_}; return _empty(); }
-	bool full() const noexcept { guard lk{mx_}; return _full(); }
-	size_type size() const noexcept  { guard lk{mx_}; return _size(); }
+	bool empty() const noexcept { return !size(); }
+	bool full() const noexcept { return size() >= capacity(); }
+	size_type size() const noexcept { return sizeSnapshot_.load(std::memory_order_relaxed); }
+	size_type capacity() const noexcept { return capacitySnapshot_.load(std::memory_order_relaxed); }
+	bool is_closed() const noexcept { return closedSnapshot_.load(std::memory_order_acquire); }
+	allocator_type get_allocator() const noexcept { return container_.allocator; }
 
-	void push(value_type const & ele) {
-		lock lk{mx_};
-		notFull_.wait(lk, [this]{ return !_full(); });
+	void close() {
+		return _resuming([&](lock &) {
+			if (closed_) return;
 
-		_pushNotify(ele);
+			closed_ = true;
+			_publishClosed();
+			consumers_.signal_all();
+			producers_.signal_all();
+			_notifySubscribers();
+			_closeAwaiters();
+		});
 	}
-	void push(value_type && ele) {
-		lock lk{mx_};
-		notFull_.wait(lk, [this]{ return !_full(); });
 
-		new(pushBuffer()) value_type{std::move(ele)};
-		++size_;
-		notEmpty_.notify_one();
+	void subscribe(WaitSignal & signal) {
+		guard lk{mx_};
+		subscribers_.push_back(&signal);
 	}
-	bool try_push(value_type const & ele) {
+	void unsubscribe(WaitSignal & signal) {
 		guard lk{mx_};
-		if (_full()) return false;
-
-		_pushNotify(ele);
-		return true;
+		subscribers_.erase(std::remove(std::begin(subscribers_), std::end(subscribers_), &signal), std::end(subscribers_));
 	}
+
+	void push(value_type const & ele) { emplace(ele); }
+	void push(value_type && ele) { emplace(std::move(ele)); }
+	bool try_push(value_type const & ele) { return try_emplace(ele); }
+	bool try_push(value_type && ele) { return try_emplace(std::move(ele)); }
 	template<class Rep, class Period>
 	bool try_push_for(T const & ele, std::chrono::duration<Rep, Period> const & timeout) {
-		lock lk{mx_};
-		if (notFull_.wait_for(lk, timeout, [this]{ return !_full(); })) {
-			_pushNotify(ele);
+		return try_emplace_for(timeout, ele);
+	}
+	template<class Rep, class Period>
+	bool try_push_for(T && ele, std::chrono::duration<Rep, Period> const & timeout) {
+		return try_emplace_for(timeout, std::move(ele));
+	}
+
+	template<typename... Args>
+	void emplace(Args &&... args) {
+		return _resuming([&](lock & lk) {
+			_waitNotFull(lk);
+
+			_emplaceNotify(std::forward<Args>(args)...);
+		});
+	}
+	template<typename... Args>
+	bool try_emplace(Args &&... args) {
+		return _resuming([&](lock &) {
+			if (closed_ || _full()) return false;
+
+			_emplaceNotify(std::forward<Args>(args)...);
 			return true;
-		}
-		return false;
+		});
+	}
+	template<class Rep, class Period, typename... Args>
+	bool try_emplace_for(std::chrono::duration<Rep, Period> const & timeout, Args &&... args) {
+		return _resuming([&](lock & lk) {
+			if (_waitNotFullFor(lk, timeout)) {
+				_emplaceNotify(std::forward<Args>(args)...);
+				return true;
+			}
+			return false;
+		});
+	}
+	template<class Clock, class Duration, typename... Args>
+	bool try_emplace_until(std::chrono::time_point<Clock, Duration> const & deadline, Args &&... args) {
+		return _resuming([&](lock & lk) {
+			if (_waitNotFullUntil(lk, deadline)) {
+				_emplaceNotify(std::forward<Args>(args)...);
+				return true;
+			}
+			return false;
+		});
+	}
+
+	template<typename InputIt>
+	void push_range(InputIt first, InputIt last) {
+		return _resuming([&](lock & lk) {
+			while (first != last) {
+				_waitNotFull(lk);
+
+				first = _pushRangeNotify(first, last);
+			}
+		});
+	}
+	template<typename InputIt>
+	InputIt try_push_range(InputIt first, InputIt last) {
+		return _resuming([&](lock &) {
+			if (closed_) return first;
+
+			return _pushRangeNotify(first, last);
+		});
 	}
 
 	value_type pop() {
-		lock lk{mx_};
-		notEmpty_.wait(lk, [this]{ return !_empty(); });
+		return _resuming([&](lock & lk) {
+			_waitNotEmpty(lk);
 
-		value_type front = std::move(_at(0));
-		_popNotify();
-		return front;
+			value_type front = std::move(_at(0));
+			_popNotify();
+			return front;
+		});
 	}
 	bool try_pop(value_type & ele) {
-		guard lk{mx_};
-		if (_empty()) return false;
+		return _resuming([&](lock &) {
+			if (_empty()) return false;
 
-		_popNotify(ele);
-		return true;
+			_popNotify(ele);
+			return true;
+		});
 	}
 	template<class Rep, class Period>
 	bool try_pop_for(value_type & ele, std::chrono::duration<Rep,Period> const & timeout) {
-		lock lk{mx_};
-		if (notEmpty_.wait_for(lk, timeout, [this]{ return !_empty(); })) {
-			_popNotify(ele);
-			return true;
-		}
-		return false;
+		return _resuming([&](lock & lk) {
+			if (_waitNotEmptyFor(lk, timeout)) {
+				_popNotify(ele);
+				return true;
+			}
+			return false;
+		});
+	}
+	template<class Clock, class Duration>
+	bool try_pop_until(value_type & ele, std::chrono::time_point<Clock, Duration> const & deadline) {
+		return _resuming([&](lock & lk) {
+			if (_waitNotEmptyUntil(lk, deadline)) {
+				_popNotify(ele);
+				return true;
+			}
+			return false;
+		});
+	}
+
+	std::optional<value_type> try_pop() {
+		return _resuming([&](lock &) -> std::optional<value_type> {
+			if (_empty()) return std::nullopt;
+
+			return _takeNotify();
+		});
+	}
+	template<class Rep, class Period>
+	std::optional<value_type> try_pop_for(std::chrono::duration<Rep,Period> const & timeout) {
+		return _resuming([&](lock & lk) -> std::optional<value_type> {
+			if (!_waitNotEmptyFor(lk, timeout)) return std::nullopt;
+
+			return _takeNotify();
+		});
+	}
+	template<class Clock, class Duration>
+	std::optional<value_type> try_pop_until(std::chrono::time_point<Clock, Duration> const & deadline) {
+		return _resuming([&](lock & lk) -> std::optional<value_type> {
+			if (!_waitNotEmptyUntil(lk, deadline)) return std::nullopt;
+
+			return _takeNotify();
+		});
+	}
+
+	template<typename OutputIt>
+	size_type pop_bulk(OutputIt out, size_type const max) {
+		if (!max) return 0;
+
+		return _resuming([&](lock & lk) {
+			_waitNotEmpty(lk);
+
+			auto const popped = _popRange(out, max);
+			_signalNotFull(popped);
+			return popped;
+		});
 	}
+	template<typename OutputIt>
+	size_type try_pop_bulk(OutputIt out, size_type const max) {
+		return _resuming([&](lock &) {
+			auto const popped = _popRange(out, max);
+			_signalNotFull(popped);
+			return popped;
+		});
+	}
+	// collects up to max elements until the deadline, everything available is taken at once on every wakeup
+	template<typename OutputIt, class Clock, class Duration>
+	size_type pop_batch(OutputIt out, size_type const max, std::chrono::time_point<Clock, Duration> const & deadline) {
+		return _resuming([&](lock & lk) {
+			size_type popped{0};
+			while (popped < max && _waitNotEmptyUntil(lk, deadline)) {
+				auto const n = _popRange(out, max - popped);
+				_signalNotFull(n);
+				popped += n;
+			}
+			if (max && !popped && closed_) throw closed_queue{};
+			return popped;
+		});
+	}
+	template<typename OutputIt, class Rep, class Period>
+	size_type pop_batch(OutputIt out, size_type const max, std::chrono::duration<Rep, Period> const & timeout) {
+		return pop_batch(out, max, std::chrono::steady_clock::now() + timeout);
+	}
+
+	template<typename Executor>
+	auto co_push(value_type const & ele, Executor & executor) { return PushAwaiter<Executor>{*this, executor, ele}; }
+	template<typename Executor>
+	auto co_push(value_type && ele, Executor & executor) { return PushAwaiter<Executor>{*this, executor, std::move(ele)}; }
+	template<typename Executor>
+	auto co_pop(Executor & executor) { return PopAwaiter<Executor>{*this, executor}; }
+
+	void swap(BoundedQueue & rhs) { _swap<alloc_traits::propagate_on_container_swap::value>(rhs); }
+private:
+	// the uninitialized ring together with the allocator it has to be given back to
+	struct Storage {
+		Storage(allocator_type const & allocator, size_type capacity) :
+				allocator{allocator}, capacity{capacity}, memory{alloc_traits::allocate(this->allocator, capacity)} {}
+		~Storage() { alloc_traits::deallocate(allocator, memory, capacity); }
+
+		Storage(Storage const &) = delete;
+		Storage & operator=(Storage const &) = delete;
+
+		template<bool PropagateAllocator>
+		void swap(Storage & rhs) noexcept {
+			using std::swap;
+			if constexpr (PropagateAllocator) swap(allocator, rhs.allocator);
+			swap(capacity, rhs.capacity);
+			swap(memory, rhs.memory);
+		}
 
-	void swap(BoundedQueue & rhs) {
+		[[no_unique_address]] allocator_type allocator;
+		size_type capacity;
+		value_type * memory;
+	};
+
+	template<bool PropagateAllocator>
+	void _swap(BoundedQueue & rhs) {
 		if (this == &rhs) return;
 
 		lock lk{mx_, std::defer_lock};
@@ -129,54 +426,353 @@ struct BoundedQueue {
 		swap(index_, rhs.index_);
 		swap(size_, rhs.size_);
 		swap(capacity_, rhs.capacity_);
-		swap(container_, rhs.container_);
+		container_.template swap<PropagateAllocator>(rhs.container_);
+		swap(closed_, rhs.closed_);
+		_publishSize();
+		_publishCapacity();
+		_publishClosed();
+		rhs._publishSize();
+		rhs._publishCapacity();
+		rhs._publishClosed();
 	}
-private:
+
 	mutable M mx_{};
-	CV notEmpty_{};
-	CV notFull_{};
+	// threads blocked until the queue is not full/not empty
+	WaitingSide<CV> producers_{};
+	WaitingSide<CV> consumers_{};
 
 	size_type index_{0};
 	size_type size_{0};
 	size_type capacity_{0};
-	memory_type container_{};
+	Storage container_;
+	bool closed_{false};
+
+	// lock-free mirrors of size_, capacity_ and closed_, only written with mx_ held
+	std::atomic<size_type> sizeSnapshot_{0};
+	std::atomic<size_type> capacitySnapshot_{0};
+	std::atomic<bool> closedSnapshot_{false};
+
+	// selectors waiting for this queue among others, they are not swapped along with the content
+	std::vector<WaitSignal *> subscribers_{};
+
+	struct Awaiting {
+		Awaiting * next{nullptr};
+		std::coroutine_handle<> handle{};
+		void * executor{nullptr};
+		void (*post)(void * executor, std::coroutine_handle<> handle) noexcept {nullptr};
+		bool closed{false};
+	};
+	struct AwaitingList {
+		Awaiting * head{nullptr};
+		Awaiting * tail{nullptr};
+
+		bool empty() const noexcept { return !head; }
+		void push_back(Awaiting & awaiting) noexcept {
+			awaiting.next = nullptr;
+			if (tail) tail->next = &awaiting;
+			else head = &awaiting;
+			tail = &awaiting;
+		}
+		Awaiting * pop_front() noexcept {
+			auto const front = head;
+			if (front) head = front->next;
+			if (!head) tail = nullptr;
+			return front;
+		}
+		AwaitingList take() noexcept { return std::exchange(*this, AwaitingList{}); }
+		void resumeAll() noexcept {
+			// the coroutine may finish and free its awaiter as soon as it is posted
+			while (auto const awaiting = pop_front()) awaiting->post(awaiting->executor, awaiting->handle);
+		}
+	};
+	struct PushAwaiting : Awaiting {
+		template<typename U>
+		explicit PushAwaiting(U && ele) : value(std::forward<U>(ele)) {}
+		value_type value;
+	};
+	struct PopAwaiting : Awaiting {
+		std::optional<value_type> value{};
+	};
+	// coroutines suspended in co_push/co_pop, and the ones that are ready to be resumed
+	AwaitingList pushAwaiters_{};
+	AwaitingList popAwaiters_{};
+	AwaitingList resumable_{};
+
+	// never blocks and never throws: an executor that can not take the coroutine (e.g. a full or shut down
+	// ThreadPool) makes it resume on the calling thread instead of leaving it suspended forever
+	template<typename Executor>
+	static void _post(void * executor, std::coroutine_handle<> handle) noexcept {
+		auto & target = *static_cast<Executor *>(executor);
+		try {
+			if constexpr (requires { { target.try_post([handle]{ handle.resume(); }) } -> std::convertible_to<bool>; }) {
+				if (target.try_post([handle]{ handle.resume(); })) return;
+			} else {
+				target.post([handle]{ handle.resume(); });
+				return;
+			}
+		} catch (...) {
+		}
+		handle.resume();
+	}
+	template<typename Executor>
+	static void _suspend(Awaiting & awaiting, AwaitingList & awaiters, Executor & executor, std::coroutine_handle<> handle) {
+		awaiting.handle = handle;
+		awaiting.executor = &executor;
+		awaiting.post = &_post<Executor>;
+		awaiters.push_back(awaiting);
+	}
+
+	template<typename Executor>
+	struct PushAwaiter : PushAwaiting {
+		template<typename U>
+		PushAwaiter(BoundedQueue & queue, Executor & executor, U && ele) : PushAwaiting{std::forward<U>(ele)}, queue_{queue}, executor_{executor} {}
+
+		bool await_ready() const noexcept { return false; }
+		bool await_suspend(std::coroutine_handle<> handle) {
+			return queue_._resuming([&](lock &) {
+				if (queue_.closed_) {
+					this->closed = true;
+					return false;
+				}
+				if (!queue_._full()) {
+					queue_._emplaceNotify(std::move(this->value));
+					return false;
+				}
+				_suspend(*this, queue_.pushAwaiters_, executor_, handle);
+				return true;
+			});
+		}
+		void await_resume() const {
+			if (this->closed) throw closed_queue{};
+		}
+	private:
+		BoundedQueue & queue_;
+		Executor & executor_;
+	};
+	template<typename Executor>
+	struct PopAwaiter : PopAwaiting {
+		PopAwaiter(BoundedQueue & queue, Executor & executor) : queue_{queue}, executor_{executor} {}
+
+		bool await_ready() const noexcept { return false; }
+		bool await_suspend(std::coroutine_handle<> handle) {
+			return queue_._resuming([&](lock &) {
+				if (!queue_._empty()) {
+					this->value = queue_._takeNotify();
+					return false;
+				}
+				if (queue_.closed_) return false;
+
+				_suspend(*this, queue_.popAwaiters_, executor_, handle);
+				return true;
+			});
+		}
+		value_type await_resume() {
+			if (!this->value) throw closed_queue{};
+			return std::move(*this->value);
+		}
+	private:
+		BoundedQueue & queue_;
+		Executor & executor_;
+	};
+
+	// runs op with the lock held, then unlocks and hands the coroutines op made ready to their executors,
+	// also when op throws. Resuming is an explicit step of every operation rather than a lock destructor,
+	// so it never runs implicitly while the stack unwinds.
+	template<typename Op>
+	auto _resuming(Op op) {
+		lock lk{mx_};
+		auto result = _runResuming(lk, op);
+		_resume(lk);
+		return result;
+	}
+	template<typename Op> requires std::is_void_v<std::invoke_result_t<Op &, lock &>>
+	void _resuming(Op op) {
+		lock lk{mx_};
+		_runResuming(lk, op);
+		_resume(lk);
+	}
+	template<typename Op>
+	decltype(auto) _runResuming(lock & lk, Op & op) {
+		try {
+			return op(lk);
+		} catch (...) {
+			if (lk.owns_lock()) _resume(lk);
+			throw;
+		}
+	}
+	void _resume(lock & lk) noexcept {
+		auto ready = resumable_.take();
+		lk.unlock();
+		ready.resumeAll();
+	}
 
 	bool _empty() const noexcept { return !size_; }
 	bool _full() const noexcept { return size_ == capacity_; }
 	size_type _size() const noexcept { return size_; }
+	void _publishSize() noexcept { sizeSnapshot_.store(size_, std::memory_order_relaxed); }
+	void _publishCapacity() noexcept { capacitySnapshot_.store(capacity_, std::memory_order_relaxed); }
+	void _publishClosed() noexcept { closedSnapshot_.store(closed_, std::memory_order_release); }
 
-	void _push(value_type const & ele) {
-		new(pushBuffer()) value_type{ele};
+	template<typename... Args>
+	void _emplace(Args &&... args) {
+		new(pushBuffer()) value_type(std::forward<Args>(args)...);
 		++size_;
+		_publishSize();
 	}
-	void _pushNotify(value_type const & ele) {
-		_push(ele);
-		notEmpty_.notify_one();
+	template<typename... Args>
+	void _emplaceNotify(Args &&... args) {
+		if (auto const awaiting = popAwaiters_.pop_front()) {
+			// hand-off: the element never touches the ring
+			static_cast<PopAwaiting *>(awaiting)->value.emplace(std::forward<Args>(args)...);
+			resumable_.push_back(*awaiting);
+			return;
+		}
+		_emplace(std::forward<Args>(args)...);
+		_signalNotEmpty();
 	}
 
 	void _pop() {
 		_at(0).~value_type();
 		--size_;
 		++index_;
+		_publishSize();
 	}
 	void _popNotify() {
 		_pop();
-		notFull_.notify_one();
+		_signalNotFull();
 	}
 	void _popNotify(value_type & ele) {
 		ele = std::move(_at(0));
 		_popNotify();
 	}
+	std::optional<value_type> _takeNotify() {
+		std::optional<value_type> front{std::move(_at(0))};
+		_popNotify();
+		return front;
+	}
+
+	// publishes and signals the elements pushed so far also when constructing the next one throws
+	template<typename InputIt>
+	InputIt _pushRangeNotify(InputIt first, InputIt last) {
+		size_type pushed{0};
+		try {
+			first = _pushRange(first, last, pushed);
+		} catch (...) {
+			_publishSize();
+			_signalNotEmpty(pushed);
+			throw;
+		}
+		_signalNotEmpty(pushed);
+		return first;
+	}
+	// copies into the free part of the ring, which consists of at most two contiguous segments
+	template<typename InputIt>
+	InputIt _pushRange(InputIt first, InputIt last, size_type & pushed) {
+		while (first != last && !_full()) {
+			auto const begin = calcMod(index_ + size_);
+			auto const end = begin + std::min(capacity_ - size_, capacity_ - begin);
+			for (auto slot = elements() + begin; slot != elements() + end && first != last; ++slot, ++first) {
+				new(slot) value_type(*first);
+				++size_;
+				++pushed;
+			}
+		}
+		_publishSize();
+		return first;
+	}
+	// drains the occupied part of the ring, which consists of at most two contiguous segments
+	template<typename OutputIt>
+	size_type _popRange(OutputIt & out, size_type const max) {
+		size_type popped{0};
+		while (popped < max && !_empty()) {
+			auto const begin = calcMod(index_);
+			auto const end = begin + std::min({size_, capacity_ - begin, max - popped});
+			for (auto slot = elements() + begin; slot != elements() + end; ++slot) {
+				*out++ = std::move(*slot);
+				_pop();
+				++popped;
+			}
+		}
+		return popped;
+	}
+
+	void _waitNotFull(lock & lk) { producers_.wait(lk, closed_, [this]{ return !closed_ && !_full(); }); }
+	template<class Rep, class Period>
+	bool _waitNotFullFor(lock & lk, std::chrono::duration<Rep, Period> const & timeout) {
+		return producers_.wait_for(lk, timeout, closed_, [this]{ return !closed_ && !_full(); });
+	}
+	template<class Clock, class Duration>
+	bool _waitNotFullUntil(lock & lk, std::chrono::time_point<Clock, Duration> const & deadline) {
+		return producers_.wait_until(lk, deadline, closed_, [this]{ return !closed_ && !_full(); });
+	}
+	void _waitNotEmpty(lock & lk) { consumers_.wait(lk, closed_, [this]{ return !_empty(); }); }
+	template<class Rep, class Period>
+	bool _waitNotEmptyFor(lock & lk, std::chrono::duration<Rep, Period> const & timeout) {
+		return consumers_.wait_for(lk, timeout, closed_, [this]{ return !_empty(); });
+	}
+	template<class Clock, class Duration>
+	bool _waitNotEmptyUntil(lock & lk, std::chrono::time_point<Clock, Duration> const & deadline) {
+		return consumers_.wait_until(lk, deadline, closed_, [this]{ return !_empty(); });
+	}
 
-	size_type calcMod(size_type const & i) const noexcept { return i % capacity_; }
+	void _signalNotEmpty(size_type const n = 1) {
+		if (!popAwaiters_.empty()) _handOffToPopAwaiters();
+		consumers_.signal(n);
+		if (n) _notifySubscribers();
+	}
+	void _signalNotFull(size_type const n = 1) {
+		if (!pushAwaiters_.empty()) _admitPushAwaiters();
+		producers_.signal(n);
+	}
+	void _handOffToPopAwaiters() {
+		size_type handedOff{0};
+		while (!_empty() && !popAwaiters_.empty()) {
+			auto const awaiting = popAwaiters_.pop_front();
+			static_cast<PopAwaiting *>(awaiting)->value.emplace(std::move(_at(0)));
+			_pop();
+			resumable_.push_back(*awaiting);
+			++handedOff;
+		}
+		producers_.signal(handedOff);
+	}
+	void _admitPushAwaiters() {
+		size_type admitted{0};
+		while (!_full() && !pushAwaiters_.empty()) {
+			auto const awaiting = pushAwaiters_.pop_front();
+			_emplace(std::move(static_cast<PushAwaiting *>(awaiting)->value));
+			resumable_.push_back(*awaiting);
+			++admitted;
+		}
+		consumers_.signal(admitted);
+		if (admitted) _notifySubscribers();
+	}
+	void _closeAwaiters() {
+		for (auto awaiters : {&pushAwaiters_, &popAwaiters_}) {
+			while (auto const awaiting = awaiters->pop_front()) {
+				awaiting->closed = true;
+				resumable_.push_back(*awaiting);
+			}
+		}
+	}
+	void _notifySubscribers() {
+		for (auto subscriber : subscribers_) subscriber->notify();
+	}
+	size_type calcMod(size_type const & i) const noexcept { return CapacityPolicy::index(i, capacity_); }
 
-	char * newMemory() const { return new char[sizeof(value_type) * capacity_]; }
-	value_type * elements() const { return reinterpret_cast<value_type*>(container_.get()); }
+	value_type * elements() const { return container_.memory; }
 	value_type * pushBuffer() { return elements() + calcMod(index_ + size_); }
 
 	reference _at(size_type const i) { return elements()[calcMod(index_ + i)]; }
 	const_reference _at(size_type const i) const { return elements()[calcMod(index_ + i)]; }
 };
 
+template <typename T, typename M=std::mutex, typename CapacityPolicy=ModuloCapacity>
+using FairBoundedQueue = BoundedQueue<T, M, FifoConditionVariable, CapacityPolicy>;
+
+namespace pmr {
+template <typename T, typename M=std::mutex, typename CV=std::condition_variable, typename CapacityPolicy=ModuloCapacity>
+using BoundedQueue = ::BoundedQueue<T, M, CV, CapacityPolicy, std::pmr::polymorphic_allocator<T>>;
+}
+
 #endif /* SRC_BOUNDEDQUEUE_H_ */
 
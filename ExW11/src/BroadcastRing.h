@@ -0,0 +1,209 @@
+#ifndef SRC_BROADCASTRING_H_
+#define SRC_BROADCASTRING_H_
+
+/*
+ * Single producer multicast ring in the style of the LMAX Disruptor: every reader sees every element.
+ * The producer constructs each element once in its slot and publishes it by advancing state_,
+ * each reader has its own cursor and reads the elements in place, nothing is copied per reader.
+ * - A slot is only reused when the slowest reader has released it, so a slow reader throttles the producer
+ *   (and a reader that stops releasing eventually blocks it).
+ * - Readers claim everything that is published and not yet seen as one Batch (optionally limited to max elements),
+ *   read it through const references and release it, which moves their cursor. Batches are released in claim order.
+ * - The number of readers is fixed at construction, every reader(i) must be used by one thread at a time.
+ * - Blocking uses std::atomic wait/notify. The published sequence and the closed flag share state_
+ *   so close() also wakes the readers; notify is only called if someone announced that it waits.
+ * close() is meant for the producer: publish() throws closed_queue from then on,
+ * claim() returns the remaining elements and then an empty batch.
+ */
+
+#include "BoundedQueue.h"
+#include "CapacityPolicy.h"
+#include "SlotStorage.h"
+
+#include <algorithm>
+#include <atomic>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+template <typename T, typename CapacityPolicy=PowerOfTwoCapacity>
+struct BroadcastRing {
+	using value_type = T;
+	using const_reference = value_type const &;
+	using size_type = size_t;
+	using memory_type = SlotStorage<value_type>;
+
+	static constexpr size_type cache_line_size{64};
+	static constexpr size_type all{std::numeric_limits<size_type>::max()};
+
+	struct Batch {
+		size_type size() const noexcept { return end - begin; }
+		bool empty() const noexcept { return begin == end; }
+		const_reference operator[](size_type const i) const noexcept { return ring->_slot(begin + i); }
+
+		BroadcastRing const * ring;
+		size_type begin;
+		size_type end;
+	};
+
+	struct Reader {
+		size_type available() const noexcept { return ring._published() - ring._cursor(index).claimed; }
+		Batch try_claim(size_type const max = all) { return ring._claim(index, max); }
+		Batch claim(size_type const max = all) {
+			ring._awaitPublished(ring._cursor(index).claimed);
+			return ring._claim(index, max);
+		}
+		void release(Batch const & batch) { ring._release(index, batch.end); }
+
+		// blocks until something is published, returns 0 once the ring is closed and drained
+		template<typename F>
+		size_type consume(F f, size_type const max = all) {
+			auto const batch = claim(max);
+			for (size_type i{0}; i < batch.size(); ++i) f(batch[i]);
+			release(batch);
+			return batch.size();
+		}
+
+		BroadcastRing & ring;
+		size_type const index;
+	};
+
+	BroadcastRing(size_type capacity, size_type readers) :
+			capacity_{CapacityPolicy::capacity(capacity)}, container_{capacity_}, cursors_(readers) {
+		if (!capacity) throw std::invalid_argument{"capacity must be > 0"};
+		if (!readers) throw std::invalid_argument{"readers must be > 0"};
+	}
+
+	~BroadcastRing() {
+		for (auto seq = reclaimed_; seq != next_; ++seq) _slot(seq).~value_type();
+	}
+
+	BroadcastRing(BroadcastRing const &) = delete;
+	BroadcastRing & operator=(BroadcastRing const &) = delete;
+
+	size_type capacity() const noexcept { return capacity_; }
+	size_type readers() const noexcept { return cursors_.size(); }
+	size_type published() const noexcept { return _published(); }
+	bool is_closed() const noexcept { return state_.load() & closed_bit; }
+
+	Reader reader(size_type const i) {
+		if (i >= readers()) throw std::out_of_range{"no such reader"};
+		return Reader{*this, i};
+	}
+
+	void close() {
+		state_.fetch_or(closed_bit);
+		state_.notify_all();
+	}
+
+	// producer only
+	void publish(value_type const & ele) { emplace(ele); }
+	void publish(value_type && ele) { emplace(std::move(ele)); }
+	bool try_publish(value_type const & ele) { return try_emplace(ele); }
+	bool try_publish(value_type && ele) { return try_emplace(std::move(ele)); }
+
+	template<typename... Args>
+	void emplace(Args &&... args) {
+		if (is_closed()) throw closed_queue{};
+		_awaitSlot();
+		_emplace(std::forward<Args>(args)...);
+	}
+	template<typename... Args>
+	bool try_emplace(Args &&... args) {
+		if (is_closed() || !_hasSlot()) return false;
+
+		_emplace(std::forward<Args>(args)...);
+		return true;
+	}
+
+private:
+	static constexpr size_type closed_bit{1};
+
+	struct alignas(cache_line_size) Cursor {
+		// released by the reader, read by the producer
+		std::atomic<size_type> released{0};
+		// only touched by the reader
+		size_type claimed{0};
+	};
+
+	size_type const capacity_;
+	memory_type const container_;
+	std::vector<Cursor> cursors_;
+
+	// producer side: next sequence to publish, slots below reclaimed_ are destroyed, the cached slowest released cursor
+	alignas(cache_line_size) size_type next_{0};
+	size_type reclaimed_{0};
+	size_type gate_{0};
+	std::atomic<bool> producerWaiting_{false};
+
+	// published sequence << 1 | closed_bit
+	alignas(cache_line_size) std::atomic<size_type> state_{0};
+	std::atomic<size_type> waitingReaders_{0};
+
+	size_type _published() const noexcept { return state_.load(std::memory_order_acquire) >> 1; }
+	Cursor & _cursor(size_type const i) noexcept { return cursors_[i]; }
+
+	template<typename... Args>
+	void _emplace(Args &&... args) {
+		auto & slot = _slot(next_);
+		if (next_ >= capacity_) {
+			slot.~value_type();
+			reclaimed_ = next_ - capacity_ + 1;
+		}
+		::new(&slot) value_type(std::forward<Args>(args)...);
+		++next_;
+		state_.fetch_add(size_type{2});
+		if (waitingReaders_.load()) state_.notify_all();
+	}
+
+	size_type _slowest() const noexcept {
+		auto slowest = next_;
+		for (auto const & cursor : cursors_) slowest = std::min(slowest, cursor.released.load(std::memory_order_acquire));
+		return slowest;
+	}
+	bool _hasSlot() {
+		if (next_ - gate_ < capacity_) return true;
+		gate_ = _slowest();
+		return next_ - gate_ < capacity_;
+	}
+	void _awaitSlot() {
+		while (!_hasSlot()) {
+			producerWaiting_ = true;
+			auto const slowest = std::min_element(cursors_.begin(), cursors_.end(), [](Cursor const & lhs, Cursor const & rhs){
+				return lhs.released.load() < rhs.released.load();
+			});
+			auto const seen = slowest->released.load();
+			if (next_ - seen >= capacity_) slowest->released.wait(seen);
+			producerWaiting_ = false;
+		}
+	}
+
+	void _awaitPublished(size_type const claimed) {
+		auto state = state_.load(std::memory_order_acquire);
+		if ((state >> 1) != claimed || (state & closed_bit)) return;
+
+		++waitingReaders_;
+		for (state = state_.load(); (state >> 1) == claimed && !(state & closed_bit); state = state_.load()) state_.wait(state);
+		--waitingReaders_;
+	}
+	Batch _claim(size_type const i, size_type const max) {
+		auto & cursor = _cursor(i);
+		auto const begin = cursor.claimed;
+		auto const end = begin + std::min(_published() - begin, max);
+		cursor.claimed = end;
+		return Batch{this, begin, end};
+	}
+	void _release(size_type const i, size_type const end) {
+		auto & cursor = _cursor(i);
+		cursor.released.store(end);
+		if (producerWaiting_.load()) cursor.released.notify_all();
+	}
+
+	size_type calcMod(size_type const i) const noexcept { return CapacityPolicy::index(i, capacity_); }
+
+	value_type * elements() const { return container_.get(); }
+	value_type & _slot(size_type const seq) const noexcept { return elements()[calcMod(seq)]; }
+};
+
+#endif /* SRC_BROADCASTRING_H_ */
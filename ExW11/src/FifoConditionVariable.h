@@ -0,0 +1,115 @@
+#ifndef SRC_FIFOCONDITIONVARIABLE_H_
+#define SRC_FIFOCONDITIONVARIABLE_H_
+
+/*
+ * Fair waiting policy for the CV parameter of BoundedQueue (see FairBoundedQueue).
+ * Every waiter enqueues a wait record on its own stack and sleeps on the condition variable in it,
+ * so a wakeup targets exactly one thread instead of all waiters of a shared condition variable.
+ * - Only the first record in line may return from a wait. A thread that arrives while others wait
+ *   queues up behind them even if its condition already holds, so it can not barge past them.
+ * - notify_one() and notify_all() both wake the first waiter. A waiter that leaves the line, because its
+ *   condition held or because it timed out, wakes the next one, which passes the turn on as long as the
+ *   condition keeps holding. This costs one extra wakeup per waiter when the next one has to go back to sleep.
+ * - A timed out waiter gives up its place. Like std::condition_variable it still returns true if it is
+ *   first in line and the condition holds by then, a waiter behind others returns false.
+ * The records are guarded by an internal mutex, which is always taken after the caller's lock.
+ */
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <utility>
+
+struct FifoConditionVariable {
+	FifoConditionVariable() = default;
+	FifoConditionVariable(FifoConditionVariable const &) = delete;
+	FifoConditionVariable & operator=(FifoConditionVariable const &) = delete;
+
+	template<typename LOCK, typename COND>
+	void wait(LOCK & lk, COND cond) {
+		_wait(lk, std::move(cond), no_deadline);
+	}
+	template<typename LOCK, typename REP, typename PER, typename COND>
+	bool wait_for(LOCK & lk, std::chrono::duration<REP, PER> const & timeout, COND cond) {
+		return wait_until(lk, std::chrono::steady_clock::now() + timeout, std::move(cond));
+	}
+	template<typename LOCK, typename CLOCK, typename DUR, typename COND>
+	bool wait_until(LOCK & lk, std::chrono::time_point<CLOCK, DUR> const & deadline, COND cond) {
+		return _wait(lk, std::move(cond), &deadline);
+	}
+
+	void notify_one() noexcept {
+		guard lk{mx_};
+		_wakeFirst();
+	}
+	void notify_all() noexcept { notify_one(); }
+
+private:
+	using guard = std::lock_guard<std::mutex>;
+	using lock = std::unique_lock<std::mutex>;
+
+	struct Waiter {
+		Waiter * prev{nullptr};
+		Waiter * next{nullptr};
+		bool notified{false};
+		std::condition_variable cv{};
+	};
+
+	std::mutex mx_{};
+	Waiter * first_{nullptr};
+	Waiter * last_{nullptr};
+
+	static constexpr std::chrono::steady_clock::time_point const * no_deadline{nullptr};
+
+	template<typename LOCK, typename COND, typename CLOCK, typename DUR>
+	bool _wait(LOCK & lk, COND cond, std::chrono::time_point<CLOCK, DUR> const * deadline) {
+		Waiter self{};
+		{
+			guard lkRecords{mx_};
+			if (!first_ && cond()) return true;
+			_append(self);
+		}
+		for (;;) {
+			bool timedOut{false};
+			{
+				lock lkRecords{mx_};
+				lk.unlock();
+				auto const notified = [&]{ return self.notified; };
+				if (deadline) timedOut = !self.cv.wait_until(lkRecords, *deadline, notified);
+				else self.cv.wait(lkRecords, notified);
+				self.notified = false;
+			}
+			lk.lock();
+
+			guard lkRecords{mx_};
+			bool const turn{first_ == &self};
+			bool const done{turn && cond()};
+			if (done || timedOut) {
+				_remove(self);
+				if (turn) _wakeFirst();
+				return done;
+			}
+		}
+	}
+
+	void _append(Waiter & waiter) noexcept {
+		waiter.prev = last_;
+		if (last_) last_->next = &waiter;
+		else first_ = &waiter;
+		last_ = &waiter;
+	}
+	void _remove(Waiter & waiter) noexcept {
+		if (waiter.prev) waiter.prev->next = waiter.next;
+		else first_ = waiter.next;
+		if (waiter.next) waiter.next->prev = waiter.prev;
+		else last_ = waiter.prev;
+	}
+	void _wakeFirst() noexcept {
+		if (!first_) return;
+
+		first_->notified = true;
+		first_->cv.notify_one();
+	}
+};
+
+#endif /* SRC_FIFOCONDITIONVARIABLE_H_ */
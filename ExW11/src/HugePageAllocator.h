@@ -0,0 +1,116 @@
+#ifndef SRC_HUGEPAGEALLOCATOR_H_
+#define SRC_HUGEPAGEALLOCATOR_H_
+
+/*
+ * Allocator for large rings, e.g. BoundedQueue<T, M, CV, CapacityPolicy, HugePageAllocator<T>>.
+ * On Linux an allocation of at least one huge page is mapped with mmap, aligned to the huge page size and
+ * marked with MADV_HUGEPAGE, so transparent huge pages can back it: a ring of millions of elements then needs
+ * a few hundred TLB entries instead of a few hundred thousand. Smaller allocations are mapped with normal pages.
+ * Where the memory lands depends on HugePagePlacement:
+ * - on_first_touch: nothing is touched, the kernel places every page on the node of the thread that writes it first.
+ *   Construct the queue anywhere and let the consumer (or producer) thread fill it first.
+ * - prefault: every page is touched by the allocating thread, which also takes the page faults out of the hot path.
+ * - local_node: like prefault, but the mapping is bound to the NUMA node of the allocating thread with mbind(MPOL_PREFERRED),
+ *   so it stays there even if another thread touches it first.
+ * madvise and mbind are hints: if transparent huge pages or NUMA are not available the mapping just uses normal pages.
+ * Other platforms fall back to aligned operator new.
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+
+#ifdef __linux__
+#include <linux/mempolicy.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+enum class HugePagePlacement {
+	on_first_touch,
+	prefault,
+	local_node
+};
+
+template <typename T>
+struct HugePageAllocator {
+	using value_type = T;
+	using is_always_equal = std::true_type;
+
+	static constexpr std::size_t huge_page_size{std::size_t{2} << 20};
+	static constexpr std::size_t page_size{4096};
+	static_assert(alignof(T) <= page_size, "mappings are only page aligned");
+
+	HugePageAllocator() noexcept = default;
+	explicit HugePageAllocator(HugePagePlacement placement) noexcept : placement_{placement} {}
+	template<typename U>
+	HugePageAllocator(HugePageAllocator<U> const & rhs) noexcept : placement_{rhs.placement()} {}
+
+	HugePagePlacement placement() const noexcept { return placement_; }
+
+	T * allocate(std::size_t n) {
+		if (n > std::size_t(-1) / sizeof(T)) throw std::bad_array_new_length{};
+#ifdef __linux__
+		auto const bytes = _mappedBytes(n);
+		auto const memory = bytes >= huge_page_size ? _mapHuge(bytes) : _map(bytes);
+		if (placement_ == HugePagePlacement::local_node) _bindToLocalNode(memory, bytes);
+		if (placement_ != HugePagePlacement::on_first_touch) _touch(memory, bytes);
+		return static_cast<T *>(memory);
+#else
+		return static_cast<T *>(::operator new(n * sizeof(T), std::align_val_t{alignof(T)}));
+#endif
+	}
+	void deallocate(T * memory, std::size_t n) noexcept {
+#ifdef __linux__
+		::munmap(memory, _mappedBytes(n));
+#else
+		::operator delete(memory, std::align_val_t{alignof(T)});
+#endif
+	}
+
+	template<typename U>
+	bool operator==(HugePageAllocator<U> const &) const noexcept { return true; }
+	template<typename U>
+	bool operator!=(HugePageAllocator<U> const &) const noexcept { return false; }
+
+private:
+	HugePagePlacement placement_{HugePagePlacement::on_first_touch};
+
+	static std::size_t _roundUp(std::size_t bytes, std::size_t alignment) noexcept { return (bytes + alignment - 1) / alignment * alignment; }
+	static std::size_t _mappedBytes(std::size_t n) noexcept {
+		auto const bytes = n * sizeof(T);
+		return bytes >= huge_page_size ? _roundUp(bytes, huge_page_size) : _roundUp(bytes ? bytes : 1, page_size);
+	}
+
+#ifdef __linux__
+	static void * _map(std::size_t bytes) {
+		auto const memory = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+		if (memory == MAP_FAILED) throw std::bad_alloc{};
+		return memory;
+	}
+	// transparent huge pages need huge page aligned ranges: map one huge page more and trim both ends
+	static void * _mapHuge(std::size_t bytes) {
+		auto const raw = static_cast<char *>(_map(bytes + huge_page_size));
+		auto const begin = reinterpret_cast<char *>(_roundUp(reinterpret_cast<std::uintptr_t>(raw), huge_page_size));
+		if (begin != raw) ::munmap(raw, begin - raw);
+		::munmap(begin + bytes, raw + huge_page_size - begin);
+		::madvise(begin, bytes, MADV_HUGEPAGE);
+		return begin;
+	}
+	static void _bindToLocalNode(void * memory, std::size_t bytes) noexcept {
+		unsigned cpu{}, node{};
+		if (::getcpu(&cpu, &node) || node >= sizeof(unsigned long) * 8) return;
+		unsigned long const nodes{1ul << node};
+		::syscall(SYS_mbind, memory, bytes, MPOL_PREFERRED, &nodes, sizeof(nodes) * 8, 0);
+	}
+	static void _touch(void * memory, std::size_t bytes) noexcept {
+		auto const begin = static_cast<char volatile *>(memory);
+		for (std::size_t offset{0}; offset < bytes; offset += page_size) begin[offset] = 0;
+	}
+#endif
+};
+
+#endif /* SRC_HUGEPAGEALLOCATOR_H_ */
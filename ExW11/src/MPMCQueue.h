@@ -0,0 +1,181 @@
+#ifndef SRC_MPMCQUEUE_H_
+#define SRC_MPMCQUEUE_H_
+
+/*
+ * Lock-free multi-producer/multi-consumer sibling of BoundedQueue.
+ * The raw slot array is the same as in BoundedQueue, but every slot gets a sequence counter ("turn").
+ * For the ring position pos the slot is calcMod(pos) and its round is lap(pos) = pos / capacity:
+ * - turn == 2 * round     => the slot is free for the producer of pos
+ * - turn == 2 * round + 1 => the slot holds the element for the consumer of pos
+ * Non-blocking operations claim a position with a CAS on tail_/head_ and give up when
+ * the slot is not ready. Blocking operations unconditionally claim their position with
+ * fetch_add and then wait on the slot's turn with std::atomic::wait, which spins shortly
+ * and only parks the thread when the queue is really full (or empty).
+ * Using two turn values per round also works for capacity 1.
+ * A claimed position can not be handed back, so nothing may throw between claiming and publishing a slot:
+ * T must be nothrow movable, and a copy that may throw is made before the position is claimed.
+ */
+
+#include "CapacityPolicy.h"
+#include "SlotStorage.h"
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+template <typename T, typename CapacityPolicy=ModuloCapacity>
+struct MPMCQueue {
+	using value_type = T;
+	using reference = value_type &;
+	using const_reference = value_type const &;
+	using size_type = size_t;
+	using memory_type = SlotStorage<value_type>;
+	using sequence_type = std::unique_ptr<std::atomic<size_type>[]>;
+
+	static constexpr size_type cache_line_size{64};
+
+	static_assert(std::is_nothrow_move_constructible_v<value_type> && std::is_nothrow_move_assignable_v<value_type>,
+			"a throwing move would leave a claimed slot unpublished and block the queue forever");
+
+	explicit MPMCQueue(size_type capacity) : capacity_{CapacityPolicy::capacity(capacity)}, container_{capacity_}, turns_{newTurns()} {
+		if (!capacity) throw std::invalid_argument{"capacity must be > 0"};
+	}
+
+	~MPMCQueue() {
+		for (size_type i{0}; i < capacity_; ++i) {
+			if (turns_[i].load(std::memory_order_relaxed) & 1) elements()[i].~value_type();
+		}
+	}
+
+	MPMCQueue(MPMCQueue const &) = delete;
+	MPMCQueue & operator=(MPMCQueue const &) = delete;
+
+	bool empty() const noexcept { return !size(); }
+	bool full() const noexcept { return size() == capacity_; }
+	size_type capacity() const noexcept { return capacity_; }
+	size_type size() const noexcept {
+		auto const head = head_.load(std::memory_order_acquire);
+		auto const tail = tail_.load(std::memory_order_acquire);
+		// blocked consumers may have claimed positions ahead of tail_
+		if (tail <= head) return 0;
+		return tail - head < capacity_ ? tail - head : capacity_;
+	}
+
+	void push(value_type const & ele) {
+		if constexpr (std::is_nothrow_copy_constructible_v<value_type>) _push(ele);
+		else _push(value_type(ele));
+	}
+	void push(value_type && ele) { _push(std::move(ele)); }
+	bool try_push(value_type const & ele) {
+		if constexpr (std::is_nothrow_copy_constructible_v<value_type>) return _tryPush(ele);
+		else return _tryPush(value_type(ele));
+	}
+	bool try_push(value_type && ele) { return _tryPush(std::move(ele)); }
+	template<class Rep, class Period>
+	bool try_push_for(T const & ele, std::chrono::duration<Rep, Period> const & timeout) {
+		return _waitFor(timeout, [&]{ return try_push(ele); });
+	}
+
+	value_type pop() {
+		auto const pos = head_.fetch_add(1, std::memory_order_acq_rel);
+		_waitForTurn(pos, popTurn(pos));
+		value_type front = std::move(_at(pos));
+		_release(pos);
+		return front;
+	}
+	bool try_pop(value_type & ele) {
+		size_type pos{};
+		if (!_claim(head_, pos, [this](size_type p){ return popTurn(p); })) return false;
+
+		ele = std::move(_at(pos));
+		_release(pos);
+		return true;
+	}
+	template<class Rep, class Period>
+	bool try_pop_for(value_type & ele, std::chrono::duration<Rep,Period> const & timeout) {
+		return _waitFor(timeout, [&]{ return try_pop(ele); });
+	}
+
+private:
+	size_type const capacity_;
+	memory_type const container_;
+	sequence_type const turns_;
+
+	alignas(cache_line_size) std::atomic<size_type> head_{0};
+	alignas(cache_line_size) std::atomic<size_type> tail_{0};
+
+	// only called with arguments value_type can be constructed from without throwing
+	template<typename U>
+	void _push(U && ele) noexcept {
+		auto const pos = tail_.fetch_add(1, std::memory_order_acq_rel);
+		_waitForTurn(pos, pushTurn(pos));
+		new(elements() + calcMod(pos)) value_type(std::forward<U>(ele));
+		_publish(pos, popTurn(pos));
+	}
+	template<typename U>
+	bool _tryPush(U && ele) noexcept {
+		size_type pos{};
+		if (!_claim(tail_, pos, [this](size_type p){ return pushTurn(p); })) return false;
+
+		new(elements() + calcMod(pos)) value_type(std::forward<U>(ele));
+		_publish(pos, popTurn(pos));
+		return true;
+	}
+
+	size_type pushTurn(size_type const pos) const noexcept { return 2 * CapacityPolicy::lap(pos, capacity_); }
+	size_type popTurn(size_type const pos) const noexcept { return 2 * CapacityPolicy::lap(pos, capacity_) + 1; }
+	std::atomic<size_type> & _turn(size_type const pos) const noexcept { return turns_[calcMod(pos)]; }
+
+	template<typename TurnFor>
+	bool _claim(std::atomic<size_type> & index, size_type & pos, TurnFor turnFor) {
+		pos = index.load(std::memory_order_acquire);
+		for (;;) {
+			if (_turn(pos).load(std::memory_order_acquire) == turnFor(pos)) {
+				if (index.compare_exchange_weak(pos, pos + 1, std::memory_order_acq_rel)) return true;
+			} else {
+				auto const previous = pos;
+				pos = index.load(std::memory_order_acquire);
+				if (pos == previous) return false;
+			}
+		}
+	}
+	void _waitForTurn(size_type const pos, size_type const turn) const {
+		auto & slotTurn = _turn(pos);
+		for (auto current = slotTurn.load(std::memory_order_acquire); current != turn; current = slotTurn.load(std::memory_order_acquire)) {
+			slotTurn.wait(current, std::memory_order_acquire);
+		}
+	}
+	void _publish(size_type const pos, size_type const turn) {
+		auto & slotTurn = _turn(pos);
+		slotTurn.store(turn, std::memory_order_release);
+		slotTurn.notify_all();
+	}
+	void _release(size_type const pos) {
+		_at(pos).~value_type();
+		_publish(pos, popTurn(pos) + 1);
+	}
+
+	template<class Rep, class Period, typename Pred>
+	static bool _waitFor(std::chrono::duration<Rep, Period> const & timeout, Pred pred) {
+		auto const deadline = std::chrono::steady_clock::now() + timeout;
+		for (unsigned spins{0}; !pred(); ++spins) {
+			if (std::chrono::steady_clock::now() >= deadline) return false;
+			if (spins >= max_spins) std::this_thread::yield();
+		}
+		return true;
+	}
+	static constexpr unsigned max_spins{64};
+
+	size_type calcMod(size_type const & i) const noexcept { return CapacityPolicy::index(i, capacity_); }
+
+	std::atomic<size_type> * newTurns() const { return new std::atomic<size_type>[capacity_]{}; }
+	value_type * elements() const { return container_.get(); }
+
+	reference _at(size_type const pos) const { return elements()[calcMod(pos)]; }
+};
+
+#endif /* SRC_MPMCQUEUE_H_ */
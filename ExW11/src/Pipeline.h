@@ -0,0 +1,384 @@
+#ifndef SRC_PIPELINE_H_
+#define SRC_PIPELINE_H_
+
+/*
+ * Linear chain of stages (e.g. ingest -> parse -> enrich -> write) linked by BoundedQueues.
+ * source(name, f) starts the chain with a callable returning std::optional<T> (std::nullopt ends the stream),
+ * stage(name, f, workers, capacity) appends a callable In -> Out and sink(name, f, workers) ends the chain.
+ * Every stage but the sink owns the queue it writes to, capacity is the size of that queue.
+ * All workers of a stage call the same callable object, so it must be thread-safe if workers > 1.
+ * - Backpressure: a full queue blocks the stage writing to it, which stops popping its own input,
+ *   so a slow stage throttles everything upstream of it.
+ * - Shutdown: when the source ends, the last worker of every stage to finish closes the stage's output,
+ *   the stage behind drains it and closes its own output in turn. wait() joins all workers.
+ * - An exception escaping a callable cancels the pipeline and is rethrown by wait().
+ *   cancel() closes every queue: workers drop the element they hold and stop, elements still queued are discarded.
+ * - stats() may be called while the pipeline runs and after it finished. Every worker charges its time
+ *   to busy (in the callable), blocked (in a push, i.e. backpressure) or starved (in a pop) and samples the size
+ *   of its input queue after each pop. This costs a few clock reads per element, the counters are per worker.
+ *   The stage with the highest busy share is the bottleneck: upstream of it stages block, downstream they starve.
+ * Stages can only be appended before start(), the pipeline must not be moved once stages refer to it.
+ */
+
+#include "BoundedQueue.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <ostream>
+#include <stdexcept>
+#include <stop_token>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+template <typename M=std::mutex, typename CV=std::condition_variable>
+struct Pipeline {
+	template<typename T>
+	using queue_type = BoundedQueue<T, M, CV>;
+	using size_type = size_t;
+	using clock = std::chrono::steady_clock;
+
+	static constexpr size_type cache_line_size{64};
+	static constexpr size_type default_capacity{64};
+
+	struct StageStats {
+		std::string name;
+		size_type workers;
+		size_type processed;
+		// wall clock seconds from start() until the last worker of the stage finished (or until now)
+		double seconds;
+		// seconds summed over the workers
+		double busy;
+		double blocked;
+		double starved;
+		// input queue, all 0 for the source
+		size_type queued;
+		size_type capacity;
+		double mean_queued;
+		size_type peak_queued;
+
+		double throughput() const noexcept { return seconds > 0 ? processed / seconds : 0; }
+		double utilization() const noexcept {
+			auto const total = busy + blocked + starved;
+			return total > 0 ? busy / total : 0;
+		}
+	};
+
+	// the open end of the pipeline, the next stage reads from its queue
+	template<typename T>
+	struct Link {
+		template<typename F, typename R = std::invoke_result_t<F &, T &&>>
+		Link<R> stage(std::string name, F f, size_type workers = 1, size_type capacity = default_capacity) {
+			static_assert(!std::is_void_v<R>, "a stage must return its result, use sink() to end the pipeline");
+			auto & stage = pipeline._attach(&queue, std::make_unique<Transform<T, R, F>>(std::move(name), workers, queue, std::move(f), capacity));
+			return Link<R>{pipeline, stage.output};
+		}
+		template<typename F>
+		void sink(std::string name, F f, size_type workers = 1) {
+			pipeline._attach(&queue, std::make_unique<Sink<T, F>>(std::move(name), workers, queue, std::move(f)));
+		}
+
+		Pipeline & pipeline;
+		queue_type<T> & queue;
+	};
+
+	Pipeline() = default;
+	~Pipeline() {
+		if (running()) cancel();
+		_join();
+	}
+
+	Pipeline(Pipeline const &) = delete;
+	Pipeline & operator=(Pipeline const &) = delete;
+
+	template<typename F, typename T = typename std::invoke_result_t<F &>::value_type>
+	Link<T> source(std::string name, F f, size_type workers = 1, size_type capacity = default_capacity) {
+		if (!stages_.empty()) throw std::logic_error{"pipeline already has a source"};
+
+		auto & stage = _attach(nullptr, std::make_unique<Source<T, F>>(std::move(name), workers, std::move(f), capacity));
+		return Link<T>{*this, stage.output};
+	}
+
+	size_type stages() const noexcept { return stages_.size(); }
+	bool running() const noexcept { return !threads_.empty(); }
+
+	void start() {
+		if (stages_.empty() || open_) throw std::logic_error{"pipeline must end with a sink"};
+		if (running() || started_) throw std::logic_error{"pipeline already started"};
+
+		started_ = true;
+		start_ = clock::now();
+		for (auto & stage : stages_) {
+			stage->running = stage->counters.size();
+			for (auto & counters : stage->counters) threads_.emplace_back([this, &stage = *stage, &counters]{ _work(stage, counters); });
+		}
+	}
+	// joins all workers, rethrows the first exception that escaped a stage
+	void wait() {
+		_join();
+		if (error_) std::rethrow_exception(error_);
+	}
+	void run() {
+		start();
+		wait();
+	}
+	void cancel() {
+		stop_.request_stop();
+		for (auto & stage : stages_) stage->closeOutput();
+	}
+
+	std::vector<StageStats> stats() const {
+		std::vector<StageStats> all{};
+		all.reserve(stages_.size());
+		for (auto const & stage : stages_) all.push_back(_stats(*stage));
+		return all;
+	}
+	// name of the stage that spends the largest share of its time in the callable
+	std::string bottleneck() const {
+		auto const all = stats();
+		auto const slowest = std::max_element(std::begin(all), std::end(all), [](StageStats const & lhs, StageStats const & rhs){
+			return lhs.utilization() < rhs.utilization();
+		});
+		return slowest == std::end(all) ? std::string{} : slowest->name;
+	}
+	void report(std::ostream & out) const {
+		auto const all = stats();
+		auto const flags = out.flags();
+		auto const precision = out.precision();
+		auto const percent = [](double part, StageStats const & stage){
+			auto const total = stage.busy + stage.blocked + stage.starved;
+			return total > 0 ? 100 * part / total : 0;
+		};
+		out << std::fixed << std::setprecision(1);
+		for (auto const & stage : all) {
+			out << std::left << std::setw(16) << stage.name << std::right
+				<< std::setw(4) << stage.workers << " workers"
+				<< std::setw(12) << stage.processed << " elements"
+				<< std::setw(14) << stage.throughput() << "/s"
+				<< "  busy " << std::setw(5) << percent(stage.busy, stage) << "%"
+				<< "  blocked " << std::setw(5) << percent(stage.blocked, stage) << "%"
+				<< "  starved " << std::setw(5) << percent(stage.starved, stage) << "%";
+			if (stage.capacity) {
+				out << "  queue " << stage.queued << "/" << stage.capacity
+					<< " mean " << stage.mean_queued << " peak " << stage.peak_queued;
+			}
+			out << '\n';
+		}
+		out << "bottleneck: " << bottleneck() << '\n';
+		out.flags(flags);
+		out.precision(precision);
+	}
+
+private:
+	struct alignas(cache_line_size) WorkerCounters {
+		// written by the worker only, read by stats()
+		std::atomic<std::uint64_t> processed{0};
+		std::atomic<std::uint64_t> busy{0};
+		std::atomic<std::uint64_t> blocked{0};
+		std::atomic<std::uint64_t> starved{0};
+		std::atomic<std::uint64_t> occupancy{0};
+		std::atomic<std::uint64_t> pops{0};
+		std::atomic<std::uint64_t> peak{0};
+		clock::time_point mark{};
+
+		// charges the nanoseconds since the previous charge to counter
+		void charge(std::atomic<std::uint64_t> & counter) noexcept {
+			auto const now = clock::now();
+			_add(counter, std::chrono::duration_cast<std::chrono::nanoseconds>(now - mark).count());
+			mark = now;
+		}
+		void sample(size_type const queued) noexcept {
+			_add(occupancy, queued);
+			_add(pops, 1);
+			if (queued > peak.load(std::memory_order_relaxed)) peak.store(queued, std::memory_order_relaxed);
+		}
+		void count() noexcept { _add(processed, 1); }
+
+	private:
+		static void _add(std::atomic<std::uint64_t> & counter, std::uint64_t const n) noexcept {
+			counter.store(counter.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+		}
+	};
+
+	struct Stage {
+		Stage(std::string name, size_type const workers) : name{std::move(name)}, counters(workers) {
+			if (!workers) throw std::invalid_argument{"workers must be > 0"};
+		}
+		virtual ~Stage() = default;
+
+		virtual void work(WorkerCounters & counters, std::stop_token const & stop) = 0;
+		virtual void closeOutput() {}
+		virtual size_type queued() const noexcept { return 0; }
+		virtual size_type capacity() const noexcept { return 0; }
+
+		std::string const name;
+		std::vector<WorkerCounters> counters;
+		std::atomic<size_type> running{0};
+		// nanoseconds from start() until the last worker finished, 0 while it runs
+		std::atomic<std::int64_t> finished{0};
+
+	protected:
+		// std::nullopt once the input is closed and drained or the pipeline is cancelled
+		template<typename T>
+		static std::optional<T> _next(queue_type<T> & input, WorkerCounters & counters, std::stop_token const & stop) {
+			std::optional<T> ele{};
+			try {
+				ele = input.pop();
+			} catch (closed_queue const &) {
+			}
+			counters.charge(counters.starved);
+			if (stop.stop_requested()) return std::nullopt;
+			if (ele) counters.sample(input.size());
+			return ele;
+		}
+		// false once the output is closed by cancel()
+		template<typename T>
+		static bool _forward(queue_type<T> & output, T && ele, WorkerCounters & counters) {
+			try {
+				output.push(std::move(ele));
+			} catch (closed_queue const &) {
+				return false;
+			}
+			counters.charge(counters.blocked);
+			counters.count();
+			return true;
+		}
+	};
+
+	template<typename Out, typename F>
+	struct Source : Stage {
+		Source(std::string name, size_type const workers, F f, size_type const capacity) :
+				Stage{std::move(name), workers}, output{capacity}, f{std::move(f)} {}
+
+		void work(WorkerCounters & counters, std::stop_token const & stop) override {
+			while (!stop.stop_requested()) {
+				auto ele = std::invoke(f);
+				counters.charge(counters.busy);
+				if (!ele || !Stage::_forward(output, std::move(*ele), counters)) return;
+			}
+		}
+		void closeOutput() override { output.close(); }
+
+		queue_type<Out> output;
+		F f;
+	};
+
+	template<typename In, typename Out, typename F>
+	struct Transform : Stage {
+		Transform(std::string name, size_type const workers, queue_type<In> & input, F f, size_type const capacity) :
+				Stage{std::move(name), workers}, input{input}, output{capacity}, f{std::move(f)} {}
+
+		void work(WorkerCounters & counters, std::stop_token const & stop) override {
+			while (auto ele = Stage::_next(input, counters, stop)) {
+				auto result = std::invoke(f, std::move(*ele));
+				counters.charge(counters.busy);
+				if (!Stage::_forward(output, std::move(result), counters)) return;
+			}
+		}
+		void closeOutput() override { output.close(); }
+		size_type queued() const noexcept override { return input.size(); }
+		size_type capacity() const noexcept override { return input.capacity(); }
+
+		queue_type<In> & input;
+		queue_type<Out> output;
+		F f;
+	};
+
+	template<typename In, typename F>
+	struct Sink : Stage {
+		Sink(std::string name, size_type const workers, queue_type<In> & input, F f) :
+				Stage{std::move(name), workers}, input{input}, f{std::move(f)} {}
+
+		void work(WorkerCounters & counters, std::stop_token const & stop) override {
+			while (auto ele = Stage::_next(input, counters, stop)) {
+				std::invoke(f, std::move(*ele));
+				counters.charge(counters.busy);
+				counters.count();
+			}
+		}
+		size_type queued() const noexcept override { return input.size(); }
+		size_type capacity() const noexcept override { return input.capacity(); }
+
+		queue_type<In> & input;
+		F f;
+	};
+
+	std::vector<std::unique_ptr<Stage>> stages_{};
+	// output queue of the last stage while nothing reads from it yet
+	void const * open_{nullptr};
+	bool started_{false};
+	clock::time_point start_{};
+	std::vector<std::thread> threads_{};
+	std::stop_source stop_{};
+	std::mutex errorMx_{};
+	std::exception_ptr error_{};
+
+	template<typename S>
+	S & _attach(void const * input, std::unique_ptr<S> stage) {
+		if (started_) throw std::logic_error{"pipeline already started"};
+		if (input != open_) throw std::logic_error{"stages can only be appended to the end of the pipeline"};
+
+		auto & attached = *stage;
+		stages_.push_back(std::move(stage));
+		if constexpr (requires { attached.output; }) open_ = &attached.output;
+		else open_ = nullptr;
+		return attached;
+	}
+
+	void _work(Stage & stage, WorkerCounters & counters) {
+		counters.mark = clock::now();
+		try {
+			stage.work(counters, stop_.get_token());
+		} catch (...) {
+			_fail(std::current_exception());
+		}
+		if (--stage.running) return;
+
+		stage.finished = std::max<std::int64_t>(1, std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now() - start_).count());
+		stage.closeOutput();
+	}
+	void _fail(std::exception_ptr error) {
+		{
+			std::lock_guard<std::mutex> lk{errorMx_};
+			if (!error_) error_ = std::move(error);
+		}
+		cancel();
+	}
+	void _join() {
+		for (auto & thread : threads_) {
+			if (thread.joinable()) thread.join();
+		}
+		threads_.clear();
+	}
+
+	StageStats _stats(Stage const & stage) const {
+		auto const seconds = [](std::uint64_t ns){ return ns / 1e9; };
+		std::uint64_t processed{0}, busy{0}, blocked{0}, starved{0}, occupancy{0}, pops{0}, peak{0};
+		for (auto const & counters : stage.counters) {
+			processed += counters.processed.load(std::memory_order_relaxed);
+			busy += counters.busy.load(std::memory_order_relaxed);
+			blocked += counters.blocked.load(std::memory_order_relaxed);
+			starved += counters.starved.load(std::memory_order_relaxed);
+			occupancy += counters.occupancy.load(std::memory_order_relaxed);
+			pops += counters.pops.load(std::memory_order_relaxed);
+			peak = std::max(peak, counters.peak.load(std::memory_order_relaxed));
+		}
+		std::int64_t elapsed{stage.finished.load()};
+		if (!elapsed && started_) elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now() - start_).count();
+		return StageStats{stage.name, stage.counters.size(), processed, seconds(elapsed), seconds(busy), seconds(blocked), seconds(starved),
+				stage.queued(), stage.capacity(), pops ? static_cast<double>(occupancy) / pops : 0, peak};
+	}
+};
+
+#endif /* SRC_PIPELINE_H_ */
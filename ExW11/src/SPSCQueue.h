@@ -0,0 +1,182 @@
+#ifndef SRC_SPSCQUEUE_H_
+#define SRC_SPSCQUEUE_H_
+
+/*
+ * Single-producer/single-consumer sibling of BoundedQueue.
+ * Exactly one thread may push and exactly one (other) thread may pop.
+ * Under that contract no mutex is needed: the producer is the only writer of tail_,
+ * the consumer is the only writer of head_, and each side merely reads the other's index.
+ * - head_ and tail_ live on separate cache lines, so the two threads do not false-share.
+ * - Each side caches the last seen index of the other side and only reloads it
+ *   when the ring looks full (producer) or empty (consumer).
+ * - Blocking push()/pop() spin shortly, then announce themselves in a waiting flag and park on the other side's
+ *   index with std::atomic::wait. The other side only notifies if the flag is set. Publishing an index and reading
+ *   the flag are sequentially consistent, so no wakeup is lost, at the price of a full barrier per push and pop.
+ * - Timed operations spin and yield until the deadline, std::atomic::wait has no timeout.
+ * Copying or moving a queue that is concurrently used makes no sense, hence it is neither.
+ */
+
+#include "CapacityPolicy.h"
+#include "SlotStorage.h"
+
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+
+template <typename T, typename CapacityPolicy=ModuloCapacity>
+struct SPSCQueue {
+	using value_type = T;
+	using reference = value_type &;
+	using const_reference = value_type const &;
+	using size_type = size_t;
+	using memory_type = SlotStorage<value_type>;
+
+	static constexpr size_type cache_line_size{64};
+
+	explicit SPSCQueue(size_type capacity) : capacity_{CapacityPolicy::capacity(capacity)}, container_{capacity_} {
+		if (!capacity) throw std::invalid_argument{"capacity must be > 0"};
+	}
+
+	~SPSCQueue() {
+		auto const tail = tail_.load(std::memory_order_acquire);
+		for (auto head = head_.load(std::memory_order_relaxed); head != tail; ++head) _at(head).~value_type();
+	}
+
+	SPSCQueue(SPSCQueue const &) = delete;
+	SPSCQueue & operator=(SPSCQueue const &) = delete;
+
+	bool empty() const noexcept { return !size(); }
+	bool full() const noexcept { return size() == capacity_; }
+	size_type capacity() const noexcept { return capacity_; }
+	size_type size() const noexcept {
+		auto const head = head_.load(std::memory_order_acquire);
+		return tail_.load(std::memory_order_acquire) - head;
+	}
+
+	void push(value_type const & ele) {
+		_awaitSpace();
+		new(pushBuffer()) value_type{ele};
+		_publishPush();
+	}
+	void push(value_type && ele) {
+		_awaitSpace();
+		new(pushBuffer()) value_type{std::move(ele)};
+		_publishPush();
+	}
+	bool try_push(value_type const & ele) {
+		if (!_hasSpace()) return false;
+
+		new(pushBuffer()) value_type{ele};
+		_publishPush();
+		return true;
+	}
+	bool try_push(value_type && ele) {
+		if (!_hasSpace()) return false;
+
+		new(pushBuffer()) value_type{std::move(ele)};
+		_publishPush();
+		return true;
+	}
+	template<class Rep, class Period>
+	bool try_push_for(T const & ele, std::chrono::duration<Rep, Period> const & timeout) {
+		return _waitFor(timeout, [&]{ return try_push(ele); });
+	}
+
+	value_type pop() {
+		_await([this]{ return _hasElement(); }, consumerWaiting_, tail_, head_.load(std::memory_order_relaxed));
+
+		value_type front = std::move(_front());
+		_publishPop();
+		return front;
+	}
+	bool try_pop(value_type & ele) {
+		if (!_hasElement()) return false;
+
+		ele = std::move(_front());
+		_publishPop();
+		return true;
+	}
+	template<class Rep, class Period>
+	bool try_pop_for(value_type & ele, std::chrono::duration<Rep,Period> const & timeout) {
+		return _waitFor(timeout, [&]{ return try_pop(ele); });
+	}
+
+private:
+	size_type const capacity_;
+	memory_type const container_;
+
+	// consumer side
+	alignas(cache_line_size) std::atomic<size_type> head_{0};
+	size_type cachedTail_{0};
+
+	// producer side
+	alignas(cache_line_size) std::atomic<size_type> tail_{0};
+	size_type cachedHead_{0};
+
+	// set by a side that is about to park, both are only written when the queue is empty or full
+	alignas(cache_line_size) std::atomic<bool> consumerWaiting_{false};
+	std::atomic<bool> producerWaiting_{false};
+
+	bool _hasSpace() {
+		auto const tail = tail_.load(std::memory_order_relaxed);
+		if (tail - cachedHead_ < capacity_) return true;
+
+		cachedHead_ = head_.load(std::memory_order_acquire);
+		return tail - cachedHead_ < capacity_;
+	}
+	void _publishPush() {
+		tail_.store(tail_.load(std::memory_order_relaxed) + 1);
+		if (consumerWaiting_.load()) tail_.notify_one();
+	}
+	void _awaitSpace() {
+		_await([this]{ return _hasSpace(); }, producerWaiting_, head_, tail_.load(std::memory_order_relaxed) - capacity_);
+	}
+
+	bool _hasElement() {
+		auto const head = head_.load(std::memory_order_relaxed);
+		if (head != cachedTail_) return true;
+
+		cachedTail_ = tail_.load(std::memory_order_acquire);
+		return head != cachedTail_;
+	}
+	void _publishPop() {
+		auto const head = head_.load(std::memory_order_relaxed);
+		_at(head).~value_type();
+		head_.store(head + 1);
+		if (producerWaiting_.load()) head_.notify_one();
+	}
+
+	// spins shortly, then parks until the other side moves index away from blocked
+	template<typename Ready>
+	static void _await(Ready ready, std::atomic<bool> & waiting, std::atomic<size_type> & index, size_type const blocked) {
+		for (unsigned spins{0}; !ready(); ++spins) {
+			if (spins < max_spins) continue;
+
+			waiting.store(true);
+			index.wait(blocked);
+			waiting.store(false, std::memory_order_relaxed);
+		}
+	}
+	template<class Rep, class Period, typename Pred>
+	static bool _waitFor(std::chrono::duration<Rep, Period> const & timeout, Pred pred) {
+		auto const deadline = std::chrono::steady_clock::now() + timeout;
+		for (unsigned spins{0}; !pred(); ++spins) {
+			if (std::chrono::steady_clock::now() >= deadline) return false;
+			if (spins >= max_spins) std::this_thread::yield();
+		}
+		return true;
+	}
+	static constexpr unsigned max_spins{64};
+
+	size_type calcMod(size_type const & i) const noexcept { return CapacityPolicy::index(i, capacity_); }
+
+	value_type * elements() const { return container_.get(); }
+	value_type * pushBuffer() { return elements() + calcMod(tail_.load(std::memory_order_relaxed)); }
+
+	reference _front() { return _at(head_.load(std::memory_order_relaxed)); }
+	reference _at(size_type const i) const { return elements()[calcMod(i)]; }
+};
+
+#endif /* SRC_SPSCQUEUE_H_ */
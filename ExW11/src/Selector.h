@@ -0,0 +1,88 @@
+#ifndef SRC_SELECTOR_H_
+#define SRC_SELECTOR_H_
+
+/*
+ * Blocks until any of several queues has data, instead of polling them with short timeouts.
+ * The Selector registers one WaitSignal with every queue for its whole lifetime; the queues notify it
+ * on push and close. wait() returns the index of a ready queue, i.e. one that is not empty or closed.
+ * With SelectOrder::round_robin the scan starts behind the queue returned last, so a busy queue can
+ * not starve the others; SelectOrder::in_order always prefers the lowest index.
+ * The scan only reads the lock-free empty()/is_closed() snapshots, it never takes a queue's lock.
+ * Readiness is a snapshot: if other threads pop from the same queues, follow up with try_pop.
+ */
+
+#include "WaitSignal.h"
+
+#include <chrono>
+#include <optional>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+enum class SelectOrder { in_order, round_robin };
+
+template <typename Queue>
+struct Selector {
+	using size_type = size_t;
+
+	explicit Selector(std::vector<Queue *> queues, SelectOrder order = SelectOrder::round_robin) :
+			queues_{std::move(queues)}, order_{order} {
+		if (queues_.empty()) throw std::invalid_argument{"selector needs at least one queue"};
+
+		for (auto queue : queues_) queue->subscribe(signal_);
+	}
+	~Selector() {
+		for (auto queue : queues_) queue->unsubscribe(signal_);
+	}
+
+	Selector(Selector const &) = delete;
+	Selector & operator=(Selector const &) = delete;
+
+	size_type size() const noexcept { return queues_.size(); }
+
+	std::optional<size_type> ready() {
+		for (size_type i{0}; i < queues_.size(); ++i) {
+			auto const index = (start_ + i) % queues_.size();
+			if (_isReady(*queues_[index])) {
+				if (order_ == SelectOrder::round_robin) start_ = index + 1;
+				return index;
+			}
+		}
+		return std::nullopt;
+	}
+
+	size_type wait() {
+		for (;;) {
+			auto const seen = signal_.epoch();
+			if (auto const index = ready()) return *index;
+			signal_.wait(seen);
+		}
+	}
+	template<class Rep, class Period>
+	std::optional<size_type> wait_for(std::chrono::duration<Rep, Period> const & timeout) {
+		return wait_until(std::chrono::steady_clock::now() + timeout);
+	}
+	template<class Clock, class Duration>
+	std::optional<size_type> wait_until(std::chrono::time_point<Clock, Duration> const & deadline) {
+		for (;;) {
+			auto const seen = signal_.epoch();
+			if (auto const index = ready()) return index;
+			if (!signal_.wait_until(seen, deadline)) return ready();
+		}
+	}
+
+private:
+	std::vector<Queue *> const queues_;
+	SelectOrder const order_;
+	size_type start_{0};
+	WaitSignal signal_{};
+
+	static bool _isReady(Queue const & queue) { return !queue.empty() || queue.is_closed(); }
+};
+
+template <typename Queue, typename... Queues>
+size_t wait_any(Queue & first, Queues &... rest) {
+	return Selector<Queue>{{&first, &rest...}, SelectOrder::in_order}.wait();
+}
+
+#endif /* SRC_SELECTOR_H_ */
@@ -0,0 +1,219 @@
+#ifndef SRC_SHARDEDQUEUE_H_
+#define SRC_SHARDEDQUEUE_H_
+
+/*
+ * A BoundedQueue split into lanes, each with its own mutex, to spread the lock contention.
+ * The aggregate capacity is distributed over the lanes, so the queue never holds more than capacity elements.
+ * Every thread has a home lane. push tries the home lane first and spills over to the other lanes,
+ * pop takes from the home lane first and steals from the other lanes.
+ * Only when all lanes are full (empty) a producer (consumer) parks in producers_ (consumers_), one Sleepers
+ * per side with its own mutex. A parking thread registers in waiting, remembers the epoch and scans the lanes
+ * once more without holding any lock but the lanes'; only then it takes the side's mutex and waits for the
+ * epoch to move on. The other side only bumps the epoch and takes that mutex when the side has sleepers,
+ * so a push never touches the producers' mutex and the steady state takes no lock beyond the lane's.
+ * FIFO order only holds per lane, not across lanes.
+ */
+
+#include "BoundedQueue.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <utility>
+#include <vector>
+
+template <typename T, typename M=std::mutex, typename CV=std::condition_variable, typename CapacityPolicy=ModuloCapacity>
+struct ShardedQueue {
+	using lane_type = BoundedQueue<T, M, CV, CapacityPolicy>;
+	using lock = std::unique_lock<M>;
+	using guard = std::lock_guard<M>;
+
+	using value_type = T;
+	using reference = value_type &;
+	using const_reference = value_type const &;
+	using size_type = size_t;
+	using time_point = std::chrono::steady_clock::time_point;
+
+	static constexpr size_type cache_line_size{64};
+
+	explicit ShardedQueue(size_type capacity, size_type lanes = defaultLanes()) {
+		if (!capacity) throw std::invalid_argument{"capacity must be > 0"};
+		if (!lanes) throw std::invalid_argument{"lanes must be > 0"};
+
+		lanes = std::min(lanes, capacity);
+		lanes_.reserve(lanes);
+		for (size_type i{0}; i < lanes; ++i) lanes_.emplace_back(capacity / lanes + (i < capacity % lanes));
+	}
+
+	ShardedQueue(ShardedQueue const &) = delete;
+	ShardedQueue & operator=(ShardedQueue const &) = delete;
+
+	static size_type defaultLanes() noexcept { return std::max(1u, std::thread::hardware_concurrency()); }
+
+	size_type lanes() const noexcept { return lanes_.size(); }
+	size_type size() const noexcept { return _sum([](lane_type const & lane){ return lane.size(); }); }
+	size_type capacity() const noexcept { return _sum([](lane_type const & lane){ return lane.capacity(); }); }
+	bool empty() const noexcept { return !size(); }
+	bool full() const noexcept { return size() >= capacity(); }
+	bool is_closed() const noexcept { return closed_.load(); }
+
+	void close() {
+		for (auto & lane : lanes_) lane.queue.close();
+		closed_ = true;
+		for (auto side : {&producers_, &consumers_}) {
+			guard lk{side->mx};
+			side->cv.notify_all();
+		}
+	}
+
+	void push(value_type const & ele) { _push([&](lane_type & lane){ return lane.try_push(ele); }); }
+	void push(value_type && ele) { _push([&](lane_type & lane){ return lane.try_push(std::move(ele)); }); }
+	bool try_push(value_type const & ele) { return _tryPush([&](lane_type & lane){ return lane.try_push(ele); }); }
+	bool try_push(value_type && ele) { return _tryPush([&](lane_type & lane){ return lane.try_push(std::move(ele)); }); }
+	template<class Rep, class Period>
+	bool try_push_for(T const & ele, std::chrono::duration<Rep, Period> const & timeout) {
+		auto const deadline = std::chrono::steady_clock::now() + timeout;
+		return _pushUntil(deadline, [&](lane_type & lane){ return lane.try_push(ele); });
+	}
+
+	value_type pop() {
+		std::optional<value_type> front{};
+		_pop([&](lane_type & lane){ return bool(front = lane.try_pop()); });
+		return std::move(*front);
+	}
+	bool try_pop(value_type & ele) { return _tryPop([&](lane_type & lane){ return lane.try_pop(ele); }); }
+	std::optional<value_type> try_pop() {
+		std::optional<value_type> front{};
+		_tryPop([&](lane_type & lane){ return bool(front = lane.try_pop()); });
+		return front;
+	}
+	template<class Rep, class Period>
+	bool try_pop_for(value_type & ele, std::chrono::duration<Rep,Period> const & timeout) {
+		auto const deadline = std::chrono::steady_clock::now() + timeout;
+		return _popUntil(deadline, [&](lane_type & lane){ return lane.try_pop(ele); });
+	}
+
+private:
+	struct alignas(cache_line_size) Lane {
+		explicit Lane(size_type capacity) : queue{capacity} {}
+		lane_type queue;
+	};
+	std::vector<Lane> lanes_{};
+
+	// threads of one side that found every lane full (empty); epoch is bumped under mx by the other side
+	struct alignas(cache_line_size) Sleepers {
+		M mx{};
+		CV cv{};
+		std::atomic<size_type> waiting{0};
+		std::atomic<size_type> epoch{0};
+	};
+	Sleepers producers_{};
+	Sleepers consumers_{};
+	std::atomic<bool> closed_{false};
+
+	static size_type _threadId() noexcept {
+		static std::atomic<size_type> nextId{0};
+		static thread_local size_type const id{nextId++};
+		return id;
+	}
+	size_type _home() const noexcept { return _threadId() % lanes_.size(); }
+
+	template<typename Op>
+	bool _anyLane(Op op) {
+		auto const home = _home();
+		for (size_type i{0}; i < lanes_.size(); ++i) {
+			if (op(lanes_[(home + i) % lanes_.size()].queue)) return true;
+		}
+		return false;
+	}
+	template<typename Get>
+	size_type _sum(Get get) const noexcept {
+		size_type sum{0};
+		for (auto const & lane : lanes_) sum += get(lane.queue);
+		return sum;
+	}
+
+	template<typename Op>
+	bool _tryPush(Op op) {
+		if (!_anyLane(op)) return false;
+
+		_signal(consumers_);
+		return true;
+	}
+	template<typename Op>
+	bool _tryPop(Op op) {
+		if (!_anyLane(op)) return false;
+
+		_signal(producers_);
+		return true;
+	}
+
+	template<typename Op>
+	void _push(Op op) {
+		if (!_pushUntil(no_deadline(), op)) throw closed_queue{};
+	}
+	template<typename Op>
+	void _pop(Op op) {
+		if (!_popUntil(no_deadline(), op)) throw closed_queue{};
+	}
+	template<typename Op>
+	bool _pushUntil(time_point const & deadline, Op op) {
+		bool const pushed = _park(deadline, producers_, [&]{
+			if (closed_) return std::optional<bool>{false};
+			if (_anyLane(op)) return std::optional<bool>{true};
+			return std::optional<bool>{};
+		});
+		if (pushed) _signal(consumers_);
+		return pushed;
+	}
+	template<typename Op>
+	bool _popUntil(time_point const & deadline, Op op) {
+		bool const popped = _park(deadline, consumers_, [&]{
+			// the lanes are closed before closed_ is set, nothing is pushed after we see it
+			bool const closed{closed_};
+			if (_anyLane(op)) return std::optional<bool>{true};
+			if (closed) return std::optional<bool>{false};
+			return std::optional<bool>{};
+		});
+		if (popped) _signal(producers_);
+		return popped;
+	}
+
+	// attempt() yields a result once the operation succeeded or can never succeed.
+	// Registering in waiting before the last scan pairs with the lane operation before _signal() reads it:
+	// either the scan sees the other side's progress or _signal() sees the sleeper and bumps the epoch.
+	template<typename Attempt>
+	bool _park(time_point const & deadline, Sleepers & side, Attempt attempt) {
+		if (auto const done = attempt()) return *done;
+
+		for (;;) {
+			side.waiting.fetch_add(1);
+			auto const seen = side.epoch.load();
+			auto const done = attempt();
+			if (!done) {
+				lock lk{side.mx};
+				auto const changed = [&]{ return side.epoch.load(std::memory_order_relaxed) != seen || closed_; };
+				if (deadline == no_deadline()) side.cv.wait(lk, changed);
+				else side.cv.wait_until(lk, deadline, changed);
+			}
+			side.waiting.fetch_sub(1);
+			if (done) return *done;
+			if (deadline != no_deadline() && std::chrono::steady_clock::now() >= deadline) return attempt().value_or(false);
+		}
+	}
+	void _signal(Sleepers & side) {
+		if (!side.waiting.load()) return;
+
+		guard lk{side.mx};
+		side.epoch.fetch_add(1);
+		side.cv.notify_one();
+	}
+
+	static time_point no_deadline() noexcept { return time_point::max(); }
+};
+
+#endif /* SRC_SHARDEDQUEUE_H_ */
@@ -0,0 +1,29 @@
+#ifndef SRC_SLOTSTORAGE_H_
+#define SRC_SLOTSTORAGE_H_
+
+/*
+ * Raw uninitialized memory for capacity elements of T, the fixed-size sibling of BoundedQueue's Storage.
+ * It is allocated through std::allocator<T> and therefore aligned for T, also for over-aligned types,
+ * where new char[] only guarantees alignof(std::max_align_t).
+ * The owning queue constructs and destroys the elements, SlotStorage only frees the memory.
+ */
+
+#include <cstddef>
+#include <memory>
+
+template <typename T>
+struct SlotStorage {
+	explicit SlotStorage(std::size_t capacity) : capacity_{capacity}, memory_{std::allocator<T>{}.allocate(capacity)} {}
+	~SlotStorage() { std::allocator<T>{}.deallocate(memory_, capacity_); }
+
+	SlotStorage(SlotStorage const &) = delete;
+	SlotStorage & operator=(SlotStorage const &) = delete;
+
+	T * get() const noexcept { return memory_; }
+
+private:
+	std::size_t const capacity_;
+	T * const memory_;
+};
+
+#endif /* SRC_SLOTSTORAGE_H_ */
@@ -0,0 +1,137 @@
+#ifndef SRC_SPINPARKCONDITIONVARIABLE_H_
+#define SRC_SPINPARKCONDITIONVARIABLE_H_
+
+/*
+ * Waiting policy for the CV parameter of BoundedQueue.
+ * A waiter first spins with exponential backoff for at most SpinMicros microseconds
+ * and only then parks in the kernel (futex on Linux, std::atomic::wait elsewhere).
+ * A waiter that gets its element within the spin window never pays a kernel sleep/wake,
+ * and notify_* only enter the kernel when a waiter is really parked.
+ * On a single core machine spinning only delays the notifier, so the waiter parks right away.
+ * Every notification bumps epoch_. The waiter samples epoch_ while it still holds the lock,
+ * hence a notification for a state change after the waiter released the lock cannot get lost.
+ */
+
+#include <atomic>
+#include <chrono>
+#include <climits>
+#include <thread>
+#include <utility>
+
+#if defined(__linux__)
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <ctime>
+#endif
+
+template<unsigned SpinMicros = 20>
+struct SpinParkConditionVariable {
+	SpinParkConditionVariable() = default;
+	SpinParkConditionVariable(SpinParkConditionVariable const &) = delete;
+	SpinParkConditionVariable & operator=(SpinParkConditionVariable const &) = delete;
+
+	template<typename LOCK, typename COND>
+	void wait(LOCK & lk, COND cond) {
+		while (!cond()) _wait(lk, no_deadline);
+	}
+	template<typename LOCK, typename REP, typename PER, typename COND>
+	bool wait_for(LOCK & lk, std::chrono::duration<REP, PER> const & timeout, COND cond) {
+		return wait_until(lk, std::chrono::steady_clock::now() + timeout, std::move(cond));
+	}
+	template<typename LOCK, typename CLOCK, typename DUR, typename COND>
+	bool wait_until(LOCK & lk, std::chrono::time_point<CLOCK, DUR> const & deadline, COND cond) {
+		while (!cond()) {
+			if (CLOCK::now() >= deadline) return false;
+			_wait(lk, &deadline);
+		}
+		return true;
+	}
+
+	void notify_one() noexcept { _notify(1); }
+	void notify_all() noexcept { _notify(INT_MAX); }
+
+private:
+	std::atomic<unsigned> epoch_{0};
+	std::atomic<unsigned> sleepers_{0};
+
+	static constexpr std::chrono::steady_clock::time_point const * no_deadline{nullptr};
+	static constexpr unsigned max_pauses{64};
+
+	template<typename LOCK, typename CLOCK, typename DUR>
+	void _wait(LOCK & lk, std::chrono::time_point<CLOCK, DUR> const * deadline) {
+		auto const epoch = epoch_.load(std::memory_order_relaxed);
+		lk.unlock();
+		if (!_spin(epoch)) {
+			sleepers_.fetch_add(1);
+			_park(epoch, deadline);
+			sleepers_.fetch_sub(1);
+		}
+		lk.lock();
+	}
+
+	bool _spin(unsigned const epoch) const {
+		static bool const single_core{std::thread::hardware_concurrency() == 1};
+		if (single_core) return epoch_.load(std::memory_order_acquire) != epoch;
+
+		auto const start = std::chrono::steady_clock::now();
+		for (unsigned pauses{1}; ; pauses = pauses < max_pauses ? 2 * pauses : max_pauses) {
+			for (unsigned i{0}; i < pauses; ++i) _pause();
+			if (epoch_.load(std::memory_order_acquire) != epoch) return true;
+			if (std::chrono::steady_clock::now() - start >= std::chrono::microseconds{SpinMicros}) return false;
+		}
+	}
+
+	static void _pause() noexcept {
+#if defined(__x86_64__) || defined(__i386__)
+		__builtin_ia32_pause();
+#elif defined(__aarch64__)
+		asm volatile("yield");
+#else
+		std::this_thread::yield();
+#endif
+	}
+
+#if defined(__linux__)
+	static_assert(sizeof(std::atomic<unsigned>) == sizeof(unsigned) && std::atomic<unsigned>::is_always_lock_free,
+			"futex needs a plain 32 bit word");
+
+	unsigned * _futexWord() noexcept { return reinterpret_cast<unsigned *>(&epoch_); }
+
+	template<typename CLOCK, typename DUR>
+	void _park(unsigned const epoch, std::chrono::time_point<CLOCK, DUR> const * deadline) {
+		if (!deadline) {
+			syscall(SYS_futex, _futexWord(), FUTEX_WAIT_PRIVATE, epoch, nullptr, nullptr, 0);
+			return;
+		}
+		auto const remaining = std::chrono::duration_cast<std::chrono::nanoseconds>(*deadline - CLOCK::now());
+		if (remaining.count() <= 0) return;
+		timespec timeout{};
+		timeout.tv_sec = static_cast<time_t>(remaining.count() / 1000000000);
+		timeout.tv_nsec = static_cast<long>(remaining.count() % 1000000000);
+		syscall(SYS_futex, _futexWord(), FUTEX_WAIT_PRIVATE, epoch, &timeout, nullptr, 0);
+	}
+	void _notify(int const waiters) noexcept {
+		epoch_.fetch_add(1);
+		if (sleepers_.load()) syscall(SYS_futex, _futexWord(), FUTEX_WAKE_PRIVATE, waiters, nullptr, nullptr, 0);
+	}
+#else
+	template<typename CLOCK, typename DUR>
+	void _park(unsigned const epoch, std::chrono::time_point<CLOCK, DUR> const * deadline) {
+		if (!deadline) {
+			epoch_.wait(epoch);
+			return;
+		}
+		// std::atomic::wait has no timeout, a timed waiter polls instead
+		while (epoch_.load() == epoch && CLOCK::now() < *deadline) std::this_thread::sleep_for(std::chrono::microseconds{50});
+	}
+	void _notify(int const waiters) noexcept {
+		epoch_.fetch_add(1);
+		if (!sleepers_.load()) return;
+		if (waiters == 1) epoch_.notify_one();
+		else epoch_.notify_all();
+	}
+#endif
+};
+
+#endif /* SRC_SPINPARKCONDITIONVARIABLE_H_ */
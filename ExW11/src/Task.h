@@ -0,0 +1,95 @@
+#ifndef SRC_TASK_H_
+#define SRC_TASK_H_
+
+/*
+ * Move-only type-erased void() callable for task queues.
+ * Unlike std::function it does not require the callable to be copyable (std::packaged_task is not)
+ * and it stores callables of up to buffer_size bytes inline, so queueing a small lambda does not allocate.
+ * Larger callables, or callables that could throw while being moved, go to the heap.
+ * The operations for the stored type live in one static table per type, the Task only keeps a pointer to it.
+ */
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+struct Task {
+	static constexpr std::size_t buffer_size{6 * sizeof(void *)};
+
+	Task() noexcept = default;
+	template<typename F, typename = std::enable_if_t<!std::is_same<std::decay_t<F>, Task>::value>>
+	Task(F && f) : ops_{&ops_for<std::decay_t<F>>} {
+		using Callable = std::decay_t<F>;
+		if constexpr (is_inline<Callable>()) ::new(buffer_) Callable(std::forward<F>(f));
+		else ::new(buffer_) Callable *{new Callable(std::forward<F>(f))};
+	}
+
+	Task(Task && rhs) noexcept : ops_{rhs.ops_} {
+		if (ops_) ops_->move(rhs.buffer_, buffer_);
+		rhs.ops_ = nullptr;
+	}
+	Task & operator=(Task && rhs) noexcept {
+		if (&rhs == this) return *this;
+
+		_reset();
+		ops_ = rhs.ops_;
+		if (ops_) ops_->move(rhs.buffer_, buffer_);
+		rhs.ops_ = nullptr;
+		return *this;
+	}
+	Task(Task const &) = delete;
+	Task & operator=(Task const &) = delete;
+
+	~Task() { _reset(); }
+
+	explicit operator bool() const noexcept { return ops_; }
+	void operator()() { ops_->call(buffer_); }
+
+	template<typename F>
+	static constexpr bool is_inline() noexcept {
+		return sizeof(F) <= buffer_size && alignof(F) <= alignof(std::max_align_t) && std::is_nothrow_move_constructible<F>::value;
+	}
+
+private:
+	struct Ops {
+		void (*call)(void * buffer);
+		// move-constructs into to and destroys from
+		void (*move)(void * from, void * to) noexcept;
+		void (*destroy)(void * buffer) noexcept;
+	};
+
+	alignas(std::max_align_t) unsigned char buffer_[buffer_size];
+	Ops const * ops_{nullptr};
+
+	void _reset() noexcept {
+		if (ops_) ops_->destroy(buffer_);
+		ops_ = nullptr;
+	}
+
+	template<typename F>
+	static F & inlined(void * buffer) noexcept { return *std::launder(static_cast<F *>(buffer)); }
+	template<typename F>
+	static F * & outlined(void * buffer) noexcept { return *std::launder(static_cast<F **>(buffer)); }
+
+	template<typename F>
+	static constexpr Ops make_ops() noexcept {
+		if constexpr (is_inline<F>()) {
+			return {
+				[](void * buffer){ inlined<F>(buffer)(); },
+				[](void * from, void * to) noexcept { ::new(to) F(std::move(inlined<F>(from))); inlined<F>(from).~F(); },
+				[](void * buffer) noexcept { inlined<F>(buffer).~F(); }
+			};
+		} else {
+			return {
+				[](void * buffer){ (*outlined<F>(buffer))(); },
+				[](void * from, void * to) noexcept { ::new(to) F *{outlined<F>(from)}; },
+				[](void * buffer) noexcept { delete outlined<F>(buffer); }
+			};
+		}
+	}
+	template<typename F>
+	static constexpr Ops ops_for{make_ops<F>()};
+};
+
+#endif /* SRC_TASK_H_ */
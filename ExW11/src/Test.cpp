@@ -11,6 +11,20 @@
 #include "bounded_queue_non_default_constructible_element_type_suite.h"
 #include "bounded_queue_single_threaded_lock_suite.h"
 #include "bounded_queue_multi_threaded_suite.h"
+#include "bounded_queue_close_suite.h"
+#include "spsc_queue_suite.h"
+#include "mpmc_queue_suite.h"
+#include "sharded_queue_suite.h"
+#include "work_stealing_deque_suite.h"
+#include "thread_pool_suite.h"
+#include "bounded_priority_queue_suite.h"
+#include "selector_suite.h"
+#include "coroutine_suite.h"
+#include "huge_page_allocator_suite.h"
+#include "two_lock_queue_suite.h"
+#include "broadcast_ring_suite.h"
+#include "fifo_condition_variable_suite.h"
+#include "pipeline_suite.h"
 
 void runAllTests(int argc, char const *argv[]){
 	//TODO add your test here
@@ -25,6 +39,20 @@ void runAllTests(int argc, char const *argv[]){
 	cute::makeRunner(lis,argc,argv)(make_suite_bounded_queue_non_default_constructible_element_type_suite(), "BoundedQueue Non-Default-Constructible Element Type Tests");
 	cute::makeRunner(lis,argc,argv)(make_suite_bounded_queue_single_threaded_lock_suite(), "BoundedQueue Single Threaded Lock Tests");
 	cute::makeRunner(lis,argc,argv)(make_suite_bounded_queue_multi_threaded_suite(), "BoundedQueue Multi-Threaded Tests");
+	cute::makeRunner(lis,argc,argv)(make_suite_bounded_queue_close_suite(), "BoundedQueue Close Tests");
+	cute::makeRunner(lis,argc,argv)(make_suite_spsc_queue_suite(), "SPSCQueue Tests");
+	cute::makeRunner(lis,argc,argv)(make_suite_mpmc_queue_suite(), "MPMCQueue Tests");
+	cute::makeRunner(lis,argc,argv)(make_suite_sharded_queue_suite(), "ShardedQueue Tests");
+	cute::makeRunner(lis,argc,argv)(make_suite_work_stealing_deque_suite(), "WorkStealingDeque Tests");
+	cute::makeRunner(lis,argc,argv)(make_suite_thread_pool_suite(), "ThreadPool Tests");
+	cute::makeRunner(lis,argc,argv)(make_suite_bounded_priority_queue_suite(), "BoundedPriorityQueue Tests");
+	cute::makeRunner(lis,argc,argv)(make_suite_selector_suite(), "Selector Tests");
+	cute::makeRunner(lis,argc,argv)(make_suite_coroutine_suite(), "BoundedQueue Coroutine Tests");
+	cute::makeRunner(lis,argc,argv)(make_suite_huge_page_allocator_suite(), "HugePageAllocator Tests");
+	cute::makeRunner(lis,argc,argv)(make_suite_two_lock_queue_suite(), "TwoLockQueue Tests");
+	cute::makeRunner(lis,argc,argv)(make_suite_broadcast_ring_suite(), "BroadcastRing Tests");
+	cute::makeRunner(lis,argc,argv)(make_suite_fifo_condition_variable_suite(), "FifoConditionVariable Tests");
+	cute::makeRunner(lis,argc,argv)(make_suite_pipeline_suite(), "Pipeline Tests");
 }
 
 int main(int argc, char const *argv[]){
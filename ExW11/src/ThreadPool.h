@@ -0,0 +1,88 @@
+#ifndef SRC_THREADPOOL_H_
+#define SRC_THREADPOOL_H_
+
+/*
+ * Fixed-size executor: N worker threads drain a BoundedQueue<Task>.
+ * - post() queues a fire-and-forget task, submit() additionally returns a std::future for the result.
+ *   The task itself is stored inline in the queue slot (see Task), but the future's shared state
+ *   is still allocated by std::packaged_task.
+ * - Submission blocks while the queue is full, which throttles producers that are faster than the workers.
+ *   A task must not submit to its own pool and wait for the result: with all workers doing so nobody drains the queue.
+ * - shutdown() closes the queue: further submissions throw closed_queue, the workers finish the queued tasks
+ *   and are joined. The destructor calls shutdown().
+ * An exception escaping a posted task terminates the program, as with std::thread; submit() reports it through the future.
+ */
+
+#include "BoundedQueue.h"
+#include "Task.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <future>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+template <typename M=std::mutex, typename CV=std::condition_variable>
+struct ThreadPool {
+	using queue_type = BoundedQueue<Task, M, CV>;
+	using size_type = typename queue_type::size_type;
+
+	explicit ThreadPool(size_type threads = defaultThreads(), size_type queueCapacity = 1024) : queue_{queueCapacity} {
+		if (!threads) throw std::invalid_argument{"threads must be > 0"};
+
+		workers_.reserve(threads);
+		for (size_type i{0}; i < threads; ++i) workers_.emplace_back([this]{ _work(); });
+	}
+
+	~ThreadPool() { shutdown(); }
+
+	ThreadPool(ThreadPool const &) = delete;
+	ThreadPool & operator=(ThreadPool const &) = delete;
+
+	static size_type defaultThreads() noexcept { return std::max(1u, std::thread::hardware_concurrency()); }
+
+	size_type threads() const noexcept { return workers_.size(); }
+	size_type pending() const noexcept { return queue_.size(); }
+
+	template<typename F>
+	void post(F && f) { queue_.emplace(std::forward<F>(f)); }
+	template<typename F>
+	bool try_post(F && f) { return queue_.try_emplace(std::forward<F>(f)); }
+
+	template<typename F, typename R = std::invoke_result_t<std::decay_t<F>>>
+	std::future<R> submit(F && f) {
+		std::packaged_task<R()> task{std::forward<F>(f)};
+		auto result = task.get_future();
+		queue_.emplace(std::move(task));
+		return result;
+	}
+
+	void shutdown() {
+		queue_.close();
+		for (auto & worker : workers_) {
+			if (worker.joinable()) worker.join();
+		}
+	}
+
+private:
+	queue_type queue_;
+	std::vector<std::thread> workers_{};
+
+	void _work() {
+		while (auto task = _next()) (*task)();
+	}
+	std::optional<Task> _next() {
+		try {
+			return queue_.pop();
+		} catch (closed_queue const &) {
+			return std::nullopt;
+		}
+	}
+};
+
+#endif /* SRC_THREADPOOL_H_ */
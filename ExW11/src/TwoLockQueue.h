@@ -0,0 +1,251 @@
+#ifndef SRC_TWOLOCKQUEUE_H_
+#define SRC_TWOLOCKQUEUE_H_
+
+/*
+ * Blocking bounded queue with one lock per end, after Michael & Scott's two-lock queue on a ring.
+ * Producers only take tailMx_ and write behind tail_, consumers only take headMx_ and read at head_,
+ * so one producer and one consumer never wait for each other's lock.
+ * The ends only communicate through the atomic element count_:
+ * - a producer publishes its element with the increment of count_ (release), a consumer acquires count_
+ *   before it reads the slot, and the other way round for the freed slot.
+ * - Crossing a lock is only needed on the transitions: a push into an empty queue takes headMx_ to wake a consumer,
+ *   a pop from a full queue takes tailMx_ to wake a producer. Further waiters of the same side are woken in a
+ *   cascade by the thread that was woken before, as long as there is something left for them.
+ * close() takes both locks. Blocking, try_ and timed operations and close() behave as in BoundedQueue,
+ * but there are no bulk operations and no swap, which would have to take both locks as well.
+ */
+
+#include "BoundedQueue.h"
+#include "CapacityPolicy.h"
+#include "SlotStorage.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <utility>
+
+template <typename T, typename M=std::mutex, typename CV=std::condition_variable, typename CapacityPolicy=ModuloCapacity>
+struct TwoLockQueue {
+	using guard = std::lock_guard<M>;
+	using lock = std::unique_lock<M>;
+
+	using value_type = T;
+	using reference = value_type &;
+	using const_reference = value_type const &;
+	using size_type = size_t;
+	using memory_type = SlotStorage<value_type>;
+
+	static constexpr size_type cache_line_size{64};
+
+	explicit TwoLockQueue(size_type capacity) : capacity_{CapacityPolicy::capacity(capacity)}, container_{capacity_} {
+		if (!capacity) throw std::invalid_argument{"capacity must be > 0"};
+	}
+
+	~TwoLockQueue() {
+		for (auto i = head_; i != tail_; ++i) _slot(i).~value_type();
+	}
+
+	TwoLockQueue(TwoLockQueue const &) = delete;
+	TwoLockQueue & operator=(TwoLockQueue const &) = delete;
+
+	bool empty() const noexcept { return !size(); }
+	bool full() const noexcept { return size() >= capacity_; }
+	size_type size() const noexcept { return count_.load(std::memory_order_relaxed); }
+	size_type capacity() const noexcept { return capacity_; }
+	bool is_closed() const noexcept { return closed_.load(); }
+
+	void close() {
+		lock lkHead{headMx_, std::defer_lock};
+		lock lkTail{tailMx_, std::defer_lock};
+		std::lock(lkHead, lkTail);
+		closed_ = true;
+		notEmpty_.notify_all();
+		notFull_.notify_all();
+	}
+
+	void push(value_type const & ele) { emplace(ele); }
+	void push(value_type && ele) { emplace(std::move(ele)); }
+	bool try_push(value_type const & ele) { return try_emplace(ele); }
+	bool try_push(value_type && ele) { return try_emplace(std::move(ele)); }
+	template<class Rep, class Period>
+	bool try_push_for(T const & ele, std::chrono::duration<Rep, Period> const & timeout) {
+		return _pushUntil(std::chrono::steady_clock::now() + timeout, ele);
+	}
+	template<class Rep, class Period>
+	bool try_push_for(T && ele, std::chrono::duration<Rep, Period> const & timeout) {
+		return _pushUntil(std::chrono::steady_clock::now() + timeout, std::move(ele));
+	}
+
+	template<typename... Args>
+	void emplace(Args &&... args) {
+		size_type before{};
+		{
+			lock lk{tailMx_};
+			{
+				Waiting waiting{waitingProducers_};
+				notFull_.wait(lk, [this]{ return _canPush(); });
+			}
+			if (closed_) throw closed_queue{};
+			before = _emplace(std::forward<Args>(args)...);
+		}
+		if (!before) _signalNotEmpty();
+	}
+	template<typename... Args>
+	bool try_emplace(Args &&... args) {
+		size_type before{};
+		{
+			guard lk{tailMx_};
+			if (closed_ || _full()) return false;
+			before = _emplace(std::forward<Args>(args)...);
+		}
+		if (!before) _signalNotEmpty();
+		return true;
+	}
+
+	value_type pop() {
+		std::optional<value_type> front{};
+		{
+			lock lk{headMx_};
+			{
+				Waiting waiting{waitingConsumers_};
+				notEmpty_.wait(lk, [this]{ return _canPop(); });
+			}
+			if (_empty()) throw closed_queue{};
+			front = _take();
+		}
+		return std::move(*front);
+	}
+	bool try_pop(value_type & ele) {
+		auto front = try_pop();
+		if (!front) return false;
+
+		ele = std::move(*front);
+		return true;
+	}
+	std::optional<value_type> try_pop() {
+		std::optional<value_type> front{};
+		{
+			guard lk{headMx_};
+			if (_empty()) return front;
+			front = _take();
+		}
+		return front;
+	}
+	template<class Rep, class Period>
+	bool try_pop_for(value_type & ele, std::chrono::duration<Rep,Period> const & timeout) {
+		auto front = try_pop_for(timeout);
+		if (!front) return false;
+
+		ele = std::move(*front);
+		return true;
+	}
+	template<class Rep, class Period>
+	std::optional<value_type> try_pop_for(std::chrono::duration<Rep,Period> const & timeout) {
+		return try_pop_until(std::chrono::steady_clock::now() + timeout);
+	}
+	template<class Clock, class Duration>
+	std::optional<value_type> try_pop_until(std::chrono::time_point<Clock, Duration> const & deadline) {
+		std::optional<value_type> front{};
+		{
+			lock lk{headMx_};
+			bool ready{};
+			{
+				Waiting waiting{waitingConsumers_};
+				ready = notEmpty_.wait_until(lk, deadline, [this]{ return _canPop(); });
+			}
+			if (!ready || _empty()) return front;
+			front = _take();
+		}
+		return front;
+	}
+
+private:
+	size_type const capacity_;
+	memory_type const container_;
+
+	// consumer side, head_ and waitingConsumers_ are guarded by headMx_
+	alignas(cache_line_size) M headMx_{};
+	CV notEmpty_{};
+	size_type head_{0};
+	size_type waitingConsumers_{0};
+
+	// producer side, tail_ and waitingProducers_ are guarded by tailMx_
+	alignas(cache_line_size) M tailMx_{};
+	CV notFull_{};
+	size_type tail_{0};
+	size_type waitingProducers_{0};
+
+	// the only state both sides touch, written while holding the lock of the writing side
+	alignas(cache_line_size) std::atomic<size_type> count_{0};
+	std::atomic<bool> closed_{false};
+
+	bool _empty() const noexcept { return !count_.load(std::memory_order_acquire); }
+	bool _full() const noexcept { return count_.load(std::memory_order_acquire) == capacity_; }
+	// closed_ is only set with both locks held, so reading it under either lock is enough for the predicates
+	bool _canPush() const noexcept { return closed_ || !_full(); }
+	bool _canPop() const noexcept { return closed_ || !_empty(); }
+
+	struct Waiting {
+		explicit Waiting(size_type & waiters) : waiters_{waiters} { ++waiters_; }
+		~Waiting() { --waiters_; }
+		size_type & waiters_;
+	};
+
+	template<typename... Args>
+	bool _pushUntil(std::chrono::steady_clock::time_point const & deadline, Args &&... args) {
+		size_type before{};
+		{
+			lock lk{tailMx_};
+			bool ready{};
+			{
+				Waiting waiting{waitingProducers_};
+				ready = notFull_.wait_until(lk, deadline, [this]{ return _canPush(); });
+			}
+			if (!ready || closed_) return false;
+			before = _emplace(std::forward<Args>(args)...);
+		}
+		if (!before) _signalNotEmpty();
+		return true;
+	}
+
+	// with tailMx_ held, returns the count before the push
+	template<typename... Args>
+	size_type _emplace(Args &&... args) {
+		::new(&_slot(tail_)) value_type(std::forward<Args>(args)...);
+		++tail_;
+		auto const before = count_.fetch_add(1, std::memory_order_acq_rel);
+		if (before + 1 < capacity_ && waitingProducers_) notFull_.notify_one();
+		return before;
+	}
+	// with headMx_ held
+	value_type _take() {
+		auto & slot = _slot(head_);
+		value_type front{std::move(slot)};
+		slot.~value_type();
+		++head_;
+		auto const before = count_.fetch_sub(1, std::memory_order_acq_rel);
+		if (before > 1 && waitingConsumers_) notEmpty_.notify_one();
+		if (before == capacity_) _signalNotFull();
+		return front;
+	}
+
+	void _signalNotEmpty() {
+		guard lk{headMx_};
+		if (waitingConsumers_) notEmpty_.notify_one();
+	}
+	// called from _take() with headMx_ held; tailMx_ is never held while taking headMx_, so this can not deadlock
+	void _signalNotFull() {
+		guard lk{tailMx_};
+		if (waitingProducers_) notFull_.notify_one();
+	}
+
+	size_type calcMod(size_type const i) const noexcept { return CapacityPolicy::index(i, capacity_); }
+
+	value_type * elements() const { return container_.get(); }
+	value_type & _slot(size_type const i) const noexcept { return elements()[calcMod(i)]; }
+};
+
+#endif /* SRC_TWOLOCKQUEUE_H_ */
@@ -0,0 +1,58 @@
+#ifndef SRC_WAITSIGNAL_H_
+#define SRC_WAITSIGNAL_H_
+
+/*
+ * Wakeup channel a thread can register with several queues at once (see Selector).
+ * A queue calls notify() whenever it becomes non-empty or is closed. The waiter remembers epoch()
+ * before it checks the queues and then waits until the epoch moved on, so a notify() that happens
+ * between the check and the wait is not lost. notify() only signals the condition variable
+ * while somebody is actually waiting.
+ */
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+
+struct WaitSignal {
+	using guard = std::lock_guard<std::mutex>;
+	using lock = std::unique_lock<std::mutex>;
+	using size_type = size_t;
+
+	WaitSignal() = default;
+	WaitSignal(WaitSignal const &) = delete;
+	WaitSignal & operator=(WaitSignal const &) = delete;
+
+	size_type epoch() const { guard lk{mx_}; return epoch_; }
+
+	void notify() {
+		{
+			guard lk{mx_};
+			++epoch_;
+			if (!waiting_) return;
+		}
+		cv_.notify_one();
+	}
+
+	void wait(size_type const seen) {
+		lock lk{mx_};
+		++waiting_;
+		cv_.wait(lk, [&]{ return epoch_ != seen; });
+		--waiting_;
+	}
+	template<class Clock, class Duration>
+	bool wait_until(size_type const seen, std::chrono::time_point<Clock, Duration> const & deadline) {
+		lock lk{mx_};
+		++waiting_;
+		auto const notified = cv_.wait_until(lk, deadline, [&]{ return epoch_ != seen; });
+		--waiting_;
+		return notified;
+	}
+
+private:
+	mutable std::mutex mx_{};
+	std::condition_variable cv_{};
+	size_type epoch_{0};
+	size_type waiting_{0};
+};
+
+#endif /* SRC_WAITSIGNAL_H_ */
@@ -0,0 +1,110 @@
+#ifndef SRC_WORKSTEALINGDEQUE_H_
+#define SRC_WORKSTEALINGDEQUE_H_
+
+/*
+ * Bounded Chase-Lev work-stealing deque on the same raw ring storage as BoundedQueue.
+ * One owner thread pushes and pops at the bottom (LIFO, keeps its data cache-hot),
+ * any number of thieves steal from the top (FIFO, takes the oldest work).
+ * - The owner only synchronizes with thieves when it takes the last element, then both race with a CAS on top_.
+ * - A thief reads its slot before the CAS decides whether the element is really its own, meanwhile the owner
+ *   may already overwrite the slot. Slots are therefore read and written through std::atomic_ref,
+ *   which requires T to be trivially copyable (task pointers, indices, small handles).
+ * - The ring does not grow, try_push fails when it is full.
+ * Indices are signed: the owner's pop decrements bottom_ before it looks at top_, which may go below top_.
+ */
+
+#include "CapacityPolicy.h"
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <type_traits>
+
+template <typename T, typename CapacityPolicy=PowerOfTwoCapacity>
+struct WorkStealingDeque {
+	static_assert(std::is_trivially_copyable<T>::value, "slots are accessed with std::atomic_ref");
+	static_assert(std::atomic_ref<T>::required_alignment <= alignof(std::max_align_t), "new char[] can not align the slots");
+
+	using value_type = T;
+	using size_type = size_t;
+	using index_type = std::ptrdiff_t;
+	using memory_type = std::unique_ptr<char[]>;
+
+	static constexpr size_type cache_line_size{64};
+
+	explicit WorkStealingDeque(size_type capacity) : capacity_{CapacityPolicy::capacity(capacity)}, container_{newMemory()} {
+		if (!capacity) throw std::invalid_argument{"capacity must be > 0"};
+	}
+
+	WorkStealingDeque(WorkStealingDeque const &) = delete;
+	WorkStealingDeque & operator=(WorkStealingDeque const &) = delete;
+
+	size_type capacity() const noexcept { return capacity_; }
+	size_type size() const noexcept {
+		auto const top = top_.load(std::memory_order_acquire);
+		auto const bottom = bottom_.load(std::memory_order_acquire);
+		return bottom > top ? static_cast<size_type>(bottom - top) : 0;
+	}
+	bool empty() const noexcept { return !size(); }
+
+	// owner only
+	bool try_push(value_type const & ele) {
+		auto const bottom = bottom_.load(std::memory_order_relaxed);
+		auto const top = top_.load(std::memory_order_acquire);
+		if (static_cast<size_type>(bottom - top) >= capacity_) return false;
+
+		_slot(bottom).store(ele, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_release);
+		bottom_.store(bottom + 1, std::memory_order_relaxed);
+		return true;
+	}
+	// owner only
+	std::optional<value_type> try_pop() {
+		auto const bottom = bottom_.load(std::memory_order_relaxed) - 1;
+		bottom_.store(bottom, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		auto top = top_.load(std::memory_order_relaxed);
+
+		if (top > bottom) {
+			bottom_.store(bottom + 1, std::memory_order_relaxed);
+			return std::nullopt;
+		}
+		std::optional<value_type> ele{_slot(bottom).load(std::memory_order_relaxed)};
+		if (top == bottom) {
+			// last element, a thief may be after it as well
+			if (!top_.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) ele.reset();
+			bottom_.store(bottom + 1, std::memory_order_relaxed);
+		}
+		return ele;
+	}
+	// any thread
+	std::optional<value_type> try_steal() {
+		auto top = top_.load(std::memory_order_acquire);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		auto const bottom = bottom_.load(std::memory_order_acquire);
+		if (top >= bottom) return std::nullopt;
+
+		value_type const ele = _slot(top).load(std::memory_order_relaxed);
+		if (!top_.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) return std::nullopt;
+		return ele;
+	}
+
+private:
+	size_type const capacity_;
+	memory_type const container_;
+
+	// top_ is contended by the thieves, bottom_ is written by the owner only
+	alignas(cache_line_size) std::atomic<index_type> top_{0};
+	alignas(cache_line_size) std::atomic<index_type> bottom_{0};
+
+	size_type calcMod(index_type const i) const noexcept { return CapacityPolicy::index(static_cast<size_type>(i), capacity_); }
+
+	char * newMemory() const { return new char[sizeof(value_type) * capacity_]; }
+	value_type * elements() const { return reinterpret_cast<value_type*>(container_.get()); }
+
+	std::atomic_ref<value_type> _slot(index_type const i) const noexcept { return std::atomic_ref<value_type>{elements()[calcMod(i)]}; }
+};
+
+#endif /* SRC_WORKSTEALINGDEQUE_H_ */
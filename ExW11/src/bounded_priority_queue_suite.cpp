@@ -0,0 +1,208 @@
+#include "bounded_priority_queue_suite.h"
+
+#include "cute.h"
+#include "BoundedPriorityQueue.h"
+#include "times_literal.hpp"
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace times::literal;
+using namespace std::chrono_literals;
+
+struct PrioritizedMessage {
+	PrioritizedMessage(int priority) : priority{priority} {}
+	PrioritizedMessage(PrioritizedMessage &&) = default;
+	PrioritizedMessage & operator=(PrioritizedMessage &&) = default;
+	PrioritizedMessage(PrioritizedMessage const & other) : priority{other.priority} { ++copies; }
+	PrioritizedMessage & operator=(PrioritizedMessage const & other) { priority = other.priority; ++copies; return *this; }
+
+	bool operator<(PrioritizedMessage const & other) const { return priority < other.priority; }
+
+	int priority;
+	static unsigned copies;
+};
+unsigned PrioritizedMessage::copies{0};
+
+void test_priority_queue_constructor_for_capacity_zero_throws() {
+	ASSERT_THROWS(BoundedPriorityQueue<int> queue{0}, std::invalid_argument);
+}
+
+void test_new_priority_queue_is_empty() {
+	BoundedPriorityQueue<int> const queue{5};
+	ASSERT(queue.empty());
+	ASSERT_EQUAL(5, queue.capacity());
+}
+
+void test_priority_queue_pops_greatest_first() {
+	BoundedPriorityQueue<int> queue{10};
+	std::vector<int> popped{}, expected{9, 7, 5, 4, 3, 1, 1};
+	for (int i : {3, 1, 4, 1, 5, 9, 7}) queue.push(i);
+	7_times([&]{ popped.push_back(queue.pop()); });
+	ASSERT_EQUAL(expected, popped);
+}
+
+void test_priority_queue_with_greater_pops_smallest_first() {
+	BoundedPriorityQueue<int, std::greater<int>> queue{10};
+	std::vector<int> popped{}, expected{1, 1, 3, 4, 5};
+	for (int i : {3, 1, 4, 1, 5}) queue.push(i);
+	5_times([&]{ popped.push_back(queue.pop()); });
+	ASSERT_EQUAL(expected, popped);
+}
+
+void test_priority_queue_with_stateful_comparator() {
+	auto byLength = [](std::string const & lhs, std::string const & rhs){ return lhs.size() < rhs.size(); };
+	BoundedPriorityQueue<std::string, decltype(byLength)> queue{5, byLength};
+	queue.push("ab");
+	queue.push("abcd");
+	queue.push("a");
+	ASSERT_EQUAL("abcd", queue.pop());
+}
+
+void test_full_priority_queue_rejects_try_push() {
+	BoundedPriorityQueue<int> queue{2};
+	queue.push(1);
+	queue.push(2);
+	ASSERT(queue.full());
+	ASSERT(!queue.try_push(3));
+	ASSERT(!queue.try_push_for(3, 1ms));
+}
+
+void test_empty_priority_queue_try_pop_fails() {
+	BoundedPriorityQueue<int> queue{2};
+	int val{};
+	ASSERT(!queue.try_pop(val));
+	ASSERT(!queue.try_pop_for(val, 1ms));
+	ASSERT(!queue.try_pop());
+}
+
+void test_priority_queue_never_copies_moved_elements() {
+	BoundedPriorityQueue<PrioritizedMessage> queue{16};
+	PrioritizedMessage::copies = 0;
+	for (int i = 0; i < 16; ++i) queue.push(PrioritizedMessage{(i * 7) % 16});
+	16_times([&]{ queue.pop(); });
+	ASSERT_EQUAL(0, PrioritizedMessage::copies);
+}
+
+void test_priority_queue_remaining_elements_are_destroyed() {
+	auto counter = std::make_shared<int>(0);
+	auto byCount = [](std::shared_ptr<int> const & lhs, std::shared_ptr<int> const & rhs){ return lhs.get() < rhs.get(); };
+	{
+		BoundedPriorityQueue<std::shared_ptr<int>, decltype(byCount)> queue{5, byCount};
+		3_times([&]{ queue.push(counter); });
+		ASSERT_EQUAL(4, counter.use_count());
+	}
+	ASSERT_EQUAL(1, counter.use_count());
+}
+
+void test_priority_queue_blocked_consumer_unblocks() {
+	BoundedPriorityQueue<int> queue{1};
+	auto f = std::async(std::launch::async, [&]{
+		std::this_thread::sleep_for(50ms);
+		queue.push(1);
+	});
+	ASSERT_EQUAL(1, queue.pop());
+}
+
+void test_priority_queue_blocked_producer_unblocks() {
+	BoundedPriorityQueue<int> queue{1};
+	queue.push(1);
+	auto f = std::async(std::launch::async, [&]{
+		std::this_thread::sleep_for(50ms);
+		queue.pop();
+	});
+	queue.push(2);
+	ASSERT_EQUAL(2, queue.pop());
+}
+
+void test_closed_priority_queue_drains_then_throws() {
+	BoundedPriorityQueue<int> queue{5};
+	queue.push(1);
+	queue.push(2);
+	queue.close();
+	ASSERT_THROWS(queue.push(3), closed_queue);
+	ASSERT_EQUAL(2, queue.pop());
+	ASSERT_EQUAL(1, queue.pop());
+	ASSERT_THROWS(queue.pop(), closed_queue);
+}
+
+struct PriorityCountingMutex {
+	void lock() { ++locks; }
+	void unlock() {}
+	static unsigned locks;
+};
+unsigned PriorityCountingMutex::locks{0};
+
+void test_priority_queue_is_closed_does_not_aquire_lock() {
+	BoundedPriorityQueue<int, std::less<int>, PriorityCountingMutex, std::condition_variable_any> queue{5};
+	queue.close();
+	PriorityCountingMutex::locks = 0;
+	ASSERT(queue.is_closed());
+	ASSERT_EQUAL(0, PriorityCountingMutex::locks);
+}
+
+struct alignas(64) PriorityOverAligned {
+	PriorityOverAligned(int value) : value{value} { misaligned |= reinterpret_cast<std::uintptr_t>(this) % alignof(PriorityOverAligned); }
+	PriorityOverAligned(PriorityOverAligned && other) noexcept : PriorityOverAligned{other.value} {}
+	PriorityOverAligned & operator=(PriorityOverAligned &&) = default;
+	bool operator<(PriorityOverAligned const & other) const { return value < other.value; }
+	int value;
+	static bool misaligned;
+};
+bool PriorityOverAligned::misaligned{false};
+
+void test_priority_queue_aligns_over_aligned_elements() {
+	BoundedPriorityQueue<PriorityOverAligned> queue{3};
+	PriorityOverAligned::misaligned = false;
+	queue.push(PriorityOverAligned{1});
+	queue.push(PriorityOverAligned{3});
+	queue.push(PriorityOverAligned{2});
+	ASSERT_EQUAL(3, queue.pop().value);
+	ASSERT(!PriorityOverAligned::misaligned);
+}
+
+void test_throwing_comparator_does_not_add_the_element() {
+	auto counter = std::make_shared<int>(0);
+	bool throws{false};
+	auto byCount = [&throws](std::shared_ptr<int> const & lhs, std::shared_ptr<int> const & rhs){
+		if (throws) throw std::runtime_error{"compare failed"};
+		return lhs.get() < rhs.get();
+	};
+	{
+		BoundedPriorityQueue<std::shared_ptr<int>, decltype(byCount)> queue{5, byCount};
+		queue.push(counter);
+		throws = true;
+		ASSERT_THROWS(queue.push(counter), std::runtime_error);
+		ASSERT_EQUAL(1, queue.size());
+		ASSERT_EQUAL(2, counter.use_count());
+		throws = false;
+		ASSERT_EQUAL(counter, queue.pop());
+		ASSERT(!queue.try_pop());
+	}
+	ASSERT_EQUAL(1, counter.use_count());
+}
+
+cute::suite make_suite_bounded_priority_queue_suite() {
+	cute::suite s;
+	s.push_back(CUTE(test_priority_queue_constructor_for_capacity_zero_throws));
+	s.push_back(CUTE(test_new_priority_queue_is_empty));
+	s.push_back(CUTE(test_priority_queue_pops_greatest_first));
+	s.push_back(CUTE(test_priority_queue_with_greater_pops_smallest_first));
+	s.push_back(CUTE(test_priority_queue_with_stateful_comparator));
+	s.push_back(CUTE(test_full_priority_queue_rejects_try_push));
+	s.push_back(CUTE(test_empty_priority_queue_try_pop_fails));
+	s.push_back(CUTE(test_priority_queue_never_copies_moved_elements));
+	s.push_back(CUTE(test_priority_queue_remaining_elements_are_destroyed));
+	s.push_back(CUTE(test_priority_queue_blocked_consumer_unblocks));
+	s.push_back(CUTE(test_priority_queue_blocked_producer_unblocks));
+	s.push_back(CUTE(test_closed_priority_queue_drains_then_throws));
+	s.push_back(CUTE(test_priority_queue_is_closed_does_not_aquire_lock));
+	s.push_back(CUTE(test_priority_queue_aligns_over_aligned_elements));
+	s.push_back(CUTE(test_throwing_comparator_does_not_add_the_element));
+	return s;
+}
@@ -0,0 +1,8 @@
+#ifndef BOUNDED_PRIORITY_QUEUE_SUITE_H_
+#define BOUNDED_PRIORITY_QUEUE_SUITE_H_
+
+#include "cute_suite.h"
+
+extern cute::suite make_suite_bounded_priority_queue_suite();
+
+#endif
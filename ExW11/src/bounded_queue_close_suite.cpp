@@ -0,0 +1,190 @@
+#include "bounded_queue_close_suite.h"
+
+#include "cute.h"
+#include "BoundedQueue.h"
+#include "SpinParkConditionVariable.h"
+#include "times_literal.hpp"
+#include <chrono>
+#include <future>
+#include <iterator>
+#include <thread>
+#include <vector>
+
+using namespace times::literal;
+using namespace std::chrono_literals;
+
+void test_new_queue_is_not_closed() {
+	BoundedQueue<int> const queue{5};
+	ASSERT(!queue.is_closed());
+}
+
+void test_queue_is_closed_after_close() {
+	BoundedQueue<int> queue{5};
+	queue.close();
+	ASSERT(queue.is_closed());
+}
+
+void test_close_twice_is_harmless() {
+	BoundedQueue<int> queue{5};
+	queue.close();
+	queue.close();
+	ASSERT(queue.is_closed());
+}
+
+void test_push_on_closed_queue_throws() {
+	BoundedQueue<int> queue{5};
+	queue.close();
+	ASSERT_THROWS(queue.push(1), closed_queue);
+}
+
+void test_emplace_on_closed_queue_throws() {
+	BoundedQueue<int> queue{5};
+	queue.close();
+	ASSERT_THROWS(queue.emplace(1), closed_queue);
+}
+
+void test_try_push_on_closed_queue_returns_false() {
+	BoundedQueue<int> queue{5};
+	queue.close();
+	ASSERT(!queue.try_push(1));
+	ASSERT(!queue.try_push_for(1, 1s));
+	ASSERT(!queue.try_emplace_until(std::chrono::steady_clock::now() + 1s, 1));
+	ASSERT(queue.empty());
+}
+
+void test_try_push_range_on_closed_queue_pushes_nothing() {
+	BoundedQueue<int> queue{5};
+	std::vector<int> const values{1, 2, 3};
+	queue.close();
+	ASSERT(std::begin(values) == queue.try_push_range(std::begin(values), std::end(values)));
+}
+
+void test_pop_drains_closed_queue() {
+	BoundedQueue<int> queue{5};
+	queue.push(1);
+	queue.push(2);
+	queue.close();
+	ASSERT_EQUAL(1, queue.pop());
+	ASSERT_EQUAL(2, queue.pop());
+}
+
+void test_pop_on_drained_closed_queue_throws() {
+	BoundedQueue<int> queue{5};
+	queue.push(1);
+	queue.close();
+	queue.pop();
+	ASSERT_THROWS(queue.pop(), closed_queue);
+}
+
+void test_pop_bulk_on_drained_closed_queue_throws() {
+	BoundedQueue<int> queue{5};
+	std::vector<int> popped{};
+	queue.close();
+	ASSERT_THROWS(queue.pop_bulk(std::back_inserter(popped), 5), closed_queue);
+}
+
+void test_pop_batch_on_drained_closed_queue_throws() {
+	BoundedQueue<int> queue{5};
+	std::vector<int> popped{};
+	queue.close();
+	ASSERT_THROWS(queue.pop_batch(std::back_inserter(popped), 5, 10s), closed_queue);
+}
+
+void test_pop_batch_on_closed_queue_returns_remaining_elements_without_waiting() {
+	BoundedQueue<int> queue{5};
+	std::vector<int> popped{}, expected{1, 2};
+	queue.push(1);
+	queue.push(2);
+	queue.close();
+	auto const start = std::chrono::steady_clock::now();
+	ASSERT_EQUAL(2, queue.pop_batch(std::back_inserter(popped), 5, 10s));
+	ASSERT(std::chrono::steady_clock::now() - start < 1s);
+	ASSERT_EQUAL(expected, popped);
+}
+
+void test_timed_pop_on_drained_closed_queue_does_not_wait() {
+	BoundedQueue<int> queue{5};
+	int val{};
+	queue.close();
+	auto const start = std::chrono::steady_clock::now();
+	ASSERT(!queue.try_pop_for(val, 10s));
+	ASSERT(!queue.try_pop_until(std::chrono::steady_clock::now() + 10s));
+	ASSERT(std::chrono::steady_clock::now() - start < 1s);
+}
+
+void test_closed_state_is_moved_along() {
+	BoundedQueue<int> queue{5};
+	queue.close();
+	BoundedQueue<int> moved{std::move(queue)};
+	ASSERT(moved.is_closed());
+}
+
+template<typename Queue>
+void test_close_wakes_all_blocked_consumers() {
+	Queue queue{5};
+	std::vector<std::future<void>> consumers{};
+	4_times([&]{
+		consumers.push_back(std::async(std::launch::async, [&]{ queue.pop(); }));
+	});
+	std::this_thread::sleep_for(50ms);
+
+	queue.close();
+	for (auto & consumer : consumers) {
+		ASSERT_NOT_EQUAL_TO(std::future_status::timeout, consumer.wait_for(1s));
+		ASSERT_THROWS(consumer.get(), closed_queue);
+	}
+}
+
+template<typename Queue>
+void test_close_wakes_all_blocked_producers() {
+	Queue queue{1};
+	queue.push(0);
+	std::vector<std::future<void>> producers{};
+	4_times([&]{
+		producers.push_back(std::async(std::launch::async, [&]{ queue.push(1); }));
+	});
+	std::this_thread::sleep_for(50ms);
+
+	queue.close();
+	for (auto & producer : producers) {
+		ASSERT_NOT_EQUAL_TO(std::future_status::timeout, producer.wait_for(1s));
+		ASSERT_THROWS(producer.get(), closed_queue);
+	}
+	ASSERT_EQUAL(0, queue.pop());
+}
+
+void test_close_wakes_timed_consumer() {
+	BoundedQueue<int> queue{5};
+	auto consumer = std::async(std::launch::async, [&]{ return queue.try_pop_for(10s); });
+	std::this_thread::sleep_for(50ms);
+
+	queue.close();
+	ASSERT_NOT_EQUAL_TO(std::future_status::timeout, consumer.wait_for(1s));
+	ASSERT(!consumer.get());
+}
+
+using SpinParkCloseQueue = BoundedQueue<int, std::mutex, SpinParkConditionVariable<>>;
+
+cute::suite make_suite_bounded_queue_close_suite() {
+	cute::suite s;
+	s.push_back(CUTE(test_new_queue_is_not_closed));
+	s.push_back(CUTE(test_queue_is_closed_after_close));
+	s.push_back(CUTE(test_close_twice_is_harmless));
+	s.push_back(CUTE(test_push_on_closed_queue_throws));
+	s.push_back(CUTE(test_emplace_on_closed_queue_throws));
+	s.push_back(CUTE(test_try_push_on_closed_queue_returns_false));
+	s.push_back(CUTE(test_try_push_range_on_closed_queue_pushes_nothing));
+	s.push_back(CUTE(test_pop_drains_closed_queue));
+	s.push_back(CUTE(test_pop_on_drained_closed_queue_throws));
+	s.push_back(CUTE(test_pop_bulk_on_drained_closed_queue_throws));
+	s.push_back(CUTE(test_pop_batch_on_drained_closed_queue_throws));
+	s.push_back(CUTE(test_pop_batch_on_closed_queue_returns_remaining_elements_without_waiting));
+	s.push_back(CUTE(test_timed_pop_on_drained_closed_queue_does_not_wait));
+	s.push_back(CUTE(test_closed_state_is_moved_along));
+	s.push_back(CUTE(test_close_wakes_all_blocked_consumers<BoundedQueue<int>>));
+	s.push_back(CUTE(test_close_wakes_all_blocked_producers<BoundedQueue<int>>));
+	s.push_back(CUTE(test_close_wakes_all_blocked_consumers<SpinParkCloseQueue>));
+	s.push_back(CUTE(test_close_wakes_all_blocked_producers<SpinParkCloseQueue>));
+	s.push_back(CUTE(test_close_wakes_timed_consumer));
+	return s;
+}
@@ -0,0 +1,8 @@
+#ifndef BOUNDED_QUEUE_CLOSE_SUITE_H_
+#define BOUNDED_QUEUE_CLOSE_SUITE_H_
+
+#include "cute_suite.h"
+
+extern cute::suite make_suite_bounded_queue_close_suite();
+
+#endif
@@ -3,7 +3,10 @@
 #include "cute.h"
 #include "BoundedQueue.h"
 #include "times_literal.hpp"
+#include <chrono>
+#include <iterator>
 #include <stdexcept>
+#include <vector>
 
 
 using namespace times::literal;
@@ -105,6 +108,31 @@ void test_queue_after_swap_this_has_argument_content() {
 	ASSERT_EQUAL(expectedValues, frontValues);
 }
 
+void test_queue_after_swap_reports_size_and_capacity_of_argument() {
+	BoundedQueue<int> queue { 5 }, otherQueue { 2 };
+	queue.push(1);
+	queue.push(2);
+	queue.push(3);
+	otherQueue.push(4);
+	otherQueue.push(5);
+	queue.swap(otherQueue);
+	ASSERT_EQUAL(2, queue.size());
+	ASSERT_EQUAL(2, queue.capacity());
+	ASSERT(queue.full());
+	ASSERT_EQUAL(3, otherQueue.size());
+	ASSERT_EQUAL(5, otherQueue.capacity());
+	ASSERT(!otherQueue.full());
+}
+
+void test_queue_size_follows_bulk_operations() {
+	BoundedQueue<int> queue { 5 };
+	std::vector<int> values { 1, 2, 3, 4 }, popped { };
+	queue.push_range(std::begin(values), std::end(values));
+	ASSERT_EQUAL(4, queue.size());
+	queue.try_pop_bulk(std::back_inserter(popped), 3);
+	ASSERT_EQUAL(1, queue.size());
+}
+
 void test_queue_after_swap_argument_has_this_content() {
 	std::vector<int> frontValues { }, expectedValues { 1, 2, 3 };
 	BoundedQueue<int> queue { 5 }, otherQueue { 5 };
@@ -116,6 +144,149 @@ void test_queue_after_swap_argument_has_this_content() {
 	ASSERT_EQUAL(expectedValues, frontValues);
 }
 
+void test_queue_push_range_pushes_all_elements_in_order() {
+	std::vector<int> const values { 1, 2, 3, 4 };
+	std::vector<int> frontValues { };
+	BoundedQueue<int> queue { 5 };
+	queue.push_range(std::begin(values), std::end(values));
+	4_times([&]() {frontValues.push_back(queue.pop());});
+	ASSERT_EQUAL(values, frontValues);
+}
+
+void test_queue_try_push_range_stops_when_full() {
+	std::vector<int> const values { 1, 2, 3, 4 };
+	BoundedQueue<int> queue { 3 };
+	auto const rest = queue.try_push_range(std::begin(values), std::end(values));
+	ASSERT_EQUAL(3, rest - std::begin(values));
+	ASSERT(queue.full());
+}
+
+void test_queue_push_range_wraps_around() {
+	std::vector<int> const values { 3, 4, 5 };
+	std::vector<int> frontValues { }, expectedValues { 2, 3, 4, 5 };
+	BoundedQueue<int> queue { 4 };
+	queue.push(1);
+	queue.push(2);
+	queue.pop();
+	queue.push_range(std::begin(values), std::end(values));
+	4_times([&]() {frontValues.push_back(queue.pop());});
+	ASSERT_EQUAL(expectedValues, frontValues);
+}
+
+struct ThrowingOnNegative {
+	explicit ThrowingOnNegative(int value) : value { value } {
+		if (value < 0) throw std::invalid_argument { "negative" };
+	}
+	int value;
+};
+
+void test_queue_push_range_keeps_elements_pushed_before_a_throw() {
+	std::vector<int> const values { 1, 2, -3, 4 };
+	BoundedQueue<ThrowingOnNegative> queue { 5 };
+	WaitSignal signal { };
+	queue.subscribe(signal);
+	ASSERT_THROWS(queue.push_range(std::begin(values), std::end(values)), std::invalid_argument);
+	ASSERT_EQUAL(2, queue.size());
+	ASSERT_EQUAL(1, signal.epoch());
+	ASSERT_EQUAL(1, queue.pop().value);
+	ASSERT_EQUAL(2, queue.pop().value);
+	queue.unsubscribe(signal);
+}
+
+void test_queue_pop_bulk_pops_at_most_max_elements() {
+	std::vector<int> frontValues { }, expectedValues { 1, 2 };
+	BoundedQueue<int> queue { 5 };
+	queue.push(1);
+	queue.push(2);
+	queue.push(3);
+	ASSERT_EQUAL(2, queue.pop_bulk(std::back_inserter(frontValues), 2));
+	ASSERT_EQUAL(expectedValues, frontValues);
+	ASSERT_EQUAL(1, queue.size());
+}
+
+void test_queue_pop_bulk_wraps_around() {
+	std::vector<int> frontValues { }, expectedValues { 2, 3, 4 };
+	BoundedQueue<int> queue { 3 };
+	queue.push(1);
+	queue.push(2);
+	queue.pop();
+	queue.push(3);
+	queue.push(4);
+	ASSERT_EQUAL(3, queue.try_pop_bulk(std::back_inserter(frontValues), 10));
+	ASSERT_EQUAL(expectedValues, frontValues);
+	ASSERT(queue.empty());
+}
+
+void test_queue_pop_batch_returns_as_soon_as_the_batch_is_full() {
+	std::vector<int> frontValues { }, expectedValues { 1, 2 };
+	BoundedQueue<int> queue { 5 };
+	queue.push(1);
+	queue.push(2);
+	queue.push(3);
+	auto const start = std::chrono::steady_clock::now();
+	ASSERT_EQUAL(2, queue.pop_batch(std::back_inserter(frontValues), 2, std::chrono::seconds{10}));
+	ASSERT(std::chrono::steady_clock::now() - start < std::chrono::seconds{1});
+	ASSERT_EQUAL(expectedValues, frontValues);
+	ASSERT_EQUAL(1, queue.size());
+}
+
+void test_queue_pop_batch_returns_partial_batch_at_deadline() {
+	std::vector<int> frontValues { }, expectedValues { 1 };
+	BoundedQueue<int> queue { 5 };
+	queue.push(1);
+	auto const deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds{20};
+	ASSERT_EQUAL(1, queue.pop_batch(std::back_inserter(frontValues), 5, deadline));
+	ASSERT(std::chrono::steady_clock::now() >= deadline);
+	ASSERT_EQUAL(expectedValues, frontValues);
+}
+
+void test_queue_pop_batch_on_empty_queue_times_out() {
+	std::vector<int> frontValues { };
+	BoundedQueue<int> queue { 3 };
+	ASSERT_EQUAL(0, queue.pop_batch(std::back_inserter(frontValues), 5, std::chrono::milliseconds{10}));
+	ASSERT(frontValues.empty());
+}
+
+void test_queue_try_pop_bulk_on_empty_queue_pops_nothing() {
+	std::vector<int> frontValues { };
+	BoundedQueue<int> queue { 3 };
+	ASSERT_EQUAL(0, queue.try_pop_bulk(std::back_inserter(frontValues), 10));
+	ASSERT(frontValues.empty());
+}
+
+void test_power_of_two_queue_rounds_capacity_up() {
+	BoundedQueue<int, std::mutex, std::condition_variable, PowerOfTwoCapacity> queue { 5 };
+	ASSERT_EQUAL(8, queue.capacity());
+}
+
+void test_exact_power_of_two_queue_rejects_other_capacities() {
+	using Queue = BoundedQueue<int, std::mutex, std::condition_variable, ExactPowerOfTwoCapacity>;
+	ASSERT_THROWS(Queue queue { 6 }, std::invalid_argument);
+}
+
+void test_power_of_two_queue_wrap_around_behavior_pop() {
+	BoundedQueue<int, std::mutex, std::condition_variable, ExactPowerOfTwoCapacity> queue { 4 };
+	std::vector<int> frontValues { }, expectedValues { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10 };
+	queue.push(1);
+	queue.push(2);
+	queue.push(3);
+	for (int i = 4; i <= 10; ++i) {
+		frontValues.push_back(queue.pop());
+		queue.push(i);
+	}
+	3_times([&]() {frontValues.push_back(queue.pop());});
+	ASSERT_EQUAL(expectedValues, frontValues);
+}
+
+void test_queue_optional_try_pop_gets_first_element_of_pushs() {
+	BoundedQueue<int> queue { 5 };
+	queue.push(1);
+	queue.push(2);
+	ASSERT_EQUAL(1, queue.try_pop().value());
+	ASSERT_EQUAL(2, queue.try_pop_for(std::chrono::milliseconds { 1 }).value());
+	ASSERT(queue.empty());
+}
+
 cute::suite make_suite_bounded_queue_content_suite() {
 	cute::suite s;
 	s.push_back(CUTE(test_queue_is_not_empty_after_push_rvalue));
@@ -129,6 +300,22 @@ cute::suite make_suite_bounded_queue_content_suite() {
 	s.push_back(CUTE(test_queue_wrap_around_behavior_pop));
 	s.push_back(CUTE(test_queue_after_swap_this_has_argument_content));
 	s.push_back(CUTE(test_queue_after_swap_argument_has_this_content));
+	s.push_back(CUTE(test_queue_after_swap_reports_size_and_capacity_of_argument));
+	s.push_back(CUTE(test_queue_size_follows_bulk_operations));
+	s.push_back(CUTE(test_queue_push_range_pushes_all_elements_in_order));
+	s.push_back(CUTE(test_queue_try_push_range_stops_when_full));
+	s.push_back(CUTE(test_queue_push_range_wraps_around));
+	s.push_back(CUTE(test_queue_push_range_keeps_elements_pushed_before_a_throw));
+	s.push_back(CUTE(test_queue_pop_bulk_pops_at_most_max_elements));
+	s.push_back(CUTE(test_queue_pop_bulk_wraps_around));
+	s.push_back(CUTE(test_queue_try_pop_bulk_on_empty_queue_pops_nothing));
+	s.push_back(CUTE(test_queue_pop_batch_returns_as_soon_as_the_batch_is_full));
+	s.push_back(CUTE(test_queue_pop_batch_returns_partial_batch_at_deadline));
+	s.push_back(CUTE(test_queue_pop_batch_on_empty_queue_times_out));
+	s.push_back(CUTE(test_power_of_two_queue_rounds_capacity_up));
+	s.push_back(CUTE(test_exact_power_of_two_queue_rejects_other_capacities));
+	s.push_back(CUTE(test_power_of_two_queue_wrap_around_behavior_pop));
+	s.push_back(CUTE(test_queue_optional_try_pop_gets_first_element_of_pushs));
 	return s;
 }
 
@@ -56,6 +56,27 @@ void test_full_bounded_queue_returns_false_on_try_push_for_const_lvalue() {
 	ASSERT(!queue.try_push_for(lvalue,1ns));
 }
 
+void test_empty_bounded_queue_returns_nullopt_on_try_pop() {
+	BoundedQueue<int> queue{23};
+	ASSERT(!queue.try_pop());
+}
+
+void test_empty_bounded_queue_returns_nullopt_on_try_pop_for() {
+	BoundedQueue<int> queue{23};
+	ASSERT(!queue.try_pop_for(1ns));
+}
+
+void test_empty_bounded_queue_returns_nullopt_on_try_pop_until() {
+	BoundedQueue<int> queue{23};
+	ASSERT(!queue.try_pop_until(std::chrono::steady_clock::now()));
+}
+
+void test_empty_bounded_queue_returns_false_on_try_pop_until() {
+	BoundedQueue<int> queue{23};
+	int val{};
+	ASSERT(!queue.try_pop_until(val, std::chrono::steady_clock::now() + 1ms));
+}
+
 cute::suite make_suite_bounded_queue_default_behavior_suite(){
 	cute::suite s{};
 	s.push_back(CUTE(test_int_queue_of_capacity_thousand_is_empty));
@@ -67,6 +88,10 @@ cute::suite make_suite_bounded_queue_default_behavior_suite(){
 	s.push_back(CUTE(test_full_bounded_queue_returns_false_on_try_push_rvalue));
 	s.push_back(CUTE(test_empty_bounded_queue_returns_false_on_try_pop_for));
 	s.push_back(CUTE(test_full_bounded_queue_returns_false_on_try_push_for_const_lvalue));
+	s.push_back(CUTE(test_empty_bounded_queue_returns_nullopt_on_try_pop));
+	s.push_back(CUTE(test_empty_bounded_queue_returns_nullopt_on_try_pop_for));
+	s.push_back(CUTE(test_empty_bounded_queue_returns_nullopt_on_try_pop_until));
+	s.push_back(CUTE(test_empty_bounded_queue_returns_false_on_try_pop_until));
 	return s;
 }
 
@@ -3,6 +3,8 @@
 #include "cute.h"
 #include "BoundedQueue.h"
 #include "times_literal.hpp"
+#include <cstdint>
+#include <memory_resource>
 
 
 struct AllocationTracker {
@@ -188,6 +190,92 @@ void test_copy_only_initialized_elements_in_copy_assignment(){
 	ASSERT_EQUAL(50, CopyCounter::copy_counter);
 }
 
+struct CountingResource : std::pmr::memory_resource {
+	std::size_t allocations{0};
+	std::size_t deallocations{0};
+	std::size_t bytes{0};
+
+private:
+	void * do_allocate(std::size_t size, std::size_t alignment) override {
+		++allocations;
+		bytes += size;
+		return std::pmr::new_delete_resource()->allocate(size, alignment);
+	}
+	void do_deallocate(void * memory, std::size_t size, std::size_t alignment) override {
+		++deallocations;
+		bytes -= size;
+		std::pmr::new_delete_resource()->deallocate(memory, size, alignment);
+	}
+	bool do_is_equal(std::pmr::memory_resource const & other) const noexcept override { return this == &other; }
+};
+
+void test_pmr_queue_takes_its_ring_from_the_memory_resource() {
+	CountingResource resource{};
+	{
+		pmr::BoundedQueue<int> queue{8, &resource};
+		queue.push(1);
+		ASSERT_EQUAL(1, resource.allocations);
+		ASSERT_EQUAL(8 * sizeof(int), resource.bytes);
+	}
+	ASSERT_EQUAL(1, resource.deallocations);
+	ASSERT_EQUAL(0, resource.bytes);
+}
+
+void test_pmr_queue_in_exhausted_arena_throws_bad_alloc() {
+	alignas(int) char arena[4 * sizeof(int)];
+	std::pmr::monotonic_buffer_resource resource{arena, sizeof(arena), std::pmr::null_memory_resource()};
+	pmr::BoundedQueue<int> queue{4, &resource};
+	ASSERT_THROWS((pmr::BoundedQueue<int>{4, &resource}), std::bad_alloc);
+}
+
+void test_moved_pmr_queue_keeps_its_memory_resource() {
+	CountingResource resource{};
+	pmr::BoundedQueue<int> queue{8, &resource};
+	queue.push(1);
+	pmr::BoundedQueue<int> moved{std::move(queue)};
+	ASSERT_EQUAL(&resource, moved.get_allocator().resource());
+	ASSERT_EQUAL(1, moved.pop());
+}
+
+void test_copy_assignment_keeps_the_memory_resource_of_the_target() {
+	CountingResource resource{}, other{};
+	pmr::BoundedQueue<int> queue{8, &resource}, copy{2, &other};
+	queue.push(1);
+	copy = queue;
+	ASSERT_EQUAL(&other, copy.get_allocator().resource());
+	ASSERT_EQUAL(1, other.allocations - other.deallocations);
+	ASSERT_EQUAL(1, copy.pop());
+}
+
+void test_move_assignment_between_memory_resources_moves_the_elements() {
+	CountingResource resource{}, other{};
+	pmr::BoundedQueue<int> queue{8, &resource}, moved{2, &other};
+	queue.push(1);
+	queue.push(2);
+	moved = std::move(queue);
+	ASSERT_EQUAL(&other, moved.get_allocator().resource());
+	ASSERT(queue.empty());
+	ASSERT_EQUAL(8, moved.capacity());
+	ASSERT_EQUAL(1, moved.pop());
+	ASSERT_EQUAL(2, moved.pop());
+}
+
+struct alignas(64) OverAligned {
+	OverAligned() { misaligned += reinterpret_cast<std::uintptr_t>(this) % alignof(OverAligned) != 0; }
+	OverAligned(OverAligned const &) : OverAligned{} {}
+	static unsigned misaligned;
+};
+unsigned OverAligned::misaligned{0};
+
+void test_over_aligned_elements_are_constructed_aligned() {
+	OverAligned::misaligned = 0;
+	BoundedQueue<OverAligned> queue{3};
+	3_times([&](){
+		queue.push(OverAligned{});
+	});
+	ASSERT_EQUAL(0, OverAligned::misaligned);
+}
+
 
 cute::suite make_suite_bounded_queue_heap_memory_suite() {
 	cute::suite s;
@@ -202,6 +290,12 @@ cute::suite make_suite_bounded_queue_heap_memory_suite() {
 	s.push_back(CUTE(test_move_constructor_does_not_allocate_a_new_queue));
 	s.push_back(CUTE(test_copy_assignment_one_additional_allocation));
 	s.push_back(CUTE(test_move_assignment_no_additional_allocation));
+	s.push_back(CUTE(test_pmr_queue_takes_its_ring_from_the_memory_resource));
+	s.push_back(CUTE(test_pmr_queue_in_exhausted_arena_throws_bad_alloc));
+	s.push_back(CUTE(test_moved_pmr_queue_keeps_its_memory_resource));
+	s.push_back(CUTE(test_copy_assignment_keeps_the_memory_resource_of_the_target));
+	s.push_back(CUTE(test_move_assignment_between_memory_resources_moves_the_elements));
+	s.push_back(CUTE(test_over_aligned_elements_are_constructed_aligned));
 	return s;
 }
 
@@ -1,7 +1,13 @@
 #include "bounded_queue_multi_threaded_suite.h"
 #include "cute.h"
 #include "BoundedQueue.h"
+#include "MPMCQueue.h"
+#include "SPSCQueue.h"
+#include "ShardedQueue.h"
+#include "SpinParkConditionVariable.h"
+#include <atomic>
 #include <future>
+#include <thread>
 #include <stdexcept>
 #include <algorithm>
 #include <numeric>
@@ -26,7 +32,8 @@ std::ostream & operator<<(std::ostream& out, std::future_status const & status)
 }
 
 }
-std::future<void> launchProducer(std::size_t start, std::size_t end, BoundedQueue<unsigned>& small_queue) {
+template<typename Queue>
+std::future<void> launchProducer(std::size_t start, std::size_t end, Queue& small_queue) {
 	return std::async(std::launch::async, [&, start, end]() mutable {
 		while (start < end) {
 			small_queue.push(start++);
@@ -34,8 +41,8 @@ std::future<void> launchProducer(std::size_t start, std::size_t end, BoundedQueu
 	});
 }
 
-template<typename T>
-std::future<std::vector<T>> launchConsumer(std::size_t nOfElements, BoundedQueue<T>& small_queue) {
+template<typename Queue, typename T = typename Queue::value_type>
+std::future<std::vector<T>> launchConsumer(std::size_t nOfElements, Queue& small_queue) {
 	return std::async(std::launch::async, [&, nOfElements]() {
 		std::vector<unsigned> popped_elements {};
 		for (auto i = 0u; i < nOfElements; i++) {
@@ -46,11 +53,12 @@ std::future<std::vector<T>> launchConsumer(std::size_t nOfElements, BoundedQueue
 	});
 }
 
+template<typename Queue>
 void test_one_producer_and_one_consumer() {
 	const std::size_t nOfElements = 1000;
 	std::vector<unsigned> expected(nOfElements, 0);
 	std::iota(std::begin(expected), std::end(expected), 0);
-	BoundedQueue<unsigned> small_queue { 1 };
+	Queue small_queue { 1 };
 	auto producer = launchProducer(0, nOfElements, small_queue);
 	auto consumer = launchConsumer(nOfElements, small_queue);
 	ASSERT_NOT_EQUAL_TO(std::future_status::timeout, producer.wait_for(std::chrono::seconds { 1 }));
@@ -59,11 +67,12 @@ void test_one_producer_and_one_consumer() {
 	ASSERT_EQUAL(expected, popped_elements);
 }
 
+template<typename Queue>
 void test_two_producers_and_one_consumer() {
 	const std::size_t nOfElements = 1000;
 	std::vector<unsigned> expected(nOfElements, 0);
 	std::iota(std::begin(expected), std::end(expected), 0);
-	BoundedQueue<unsigned> small_queue { 10 };
+	Queue small_queue { 10 };
 	auto producer1 = launchProducer(0, nOfElements / 2, small_queue);
 	auto producer2 = launchProducer(nOfElements / 2, nOfElements, small_queue);
 	auto consumer = launchConsumer(nOfElements, small_queue);
@@ -87,11 +96,12 @@ std::vector<T> combine_and_sort(std::vector<std::future<std::vector<T>>>& parts)
 	return result;
 }
 
+template<typename Queue>
 void test_one_producer_two_consumers() {
 	const std::size_t nOfElements = 1000;
 	std::vector<unsigned> expected(nOfElements, 0);
 	std::iota(std::begin(expected), std::end(expected), 0);
-	BoundedQueue<unsigned> small_queue { 10 };
+	Queue small_queue { 10 };
 	auto producer = launchProducer(0, nOfElements, small_queue);
 	std::vector<std::future<std::vector<unsigned>>>consumers {};
 	consumers.push_back(launchConsumer(nOfElements / 2, small_queue));
@@ -106,12 +116,13 @@ void test_one_producer_two_consumers() {
 	ASSERT_EQUAL(expected, popped_elements);
 }
 
+template<typename Queue>
 void test_ten_producers_ten_consumers() {
 	const std::size_t nOfElements = 10000;
 	const std::size_t sliceSize = nOfElements / 10;
 	std::vector<unsigned> expected(nOfElements, 0);
 	std::iota(std::begin(expected), std::end(expected), 0);
-	BoundedQueue<unsigned> queue { 10 };
+	Queue queue { 10 };
 	std::vector<std::future<void>> producers { };
 	std::vector<std::future<std::vector<unsigned>>>consumers {};
 	for (auto i = 0u; i < 10; i++) {
@@ -131,8 +142,9 @@ void test_ten_producers_ten_consumers() {
 }
 
 
+template<typename Queue>
 void test_blocked_produced_unblocks() {
-	BoundedQueue<unsigned> queue { 1 };
+	Queue queue { 1 };
 	queue.push(1);
 
 	auto f = std::async(std::launch::async, [&](){
@@ -144,8 +156,9 @@ void test_blocked_produced_unblocks() {
 	ASSERT_EQUAL(2, queue.pop());
 }
 
+template<typename Queue>
 void test_blocked_consumer_unblocks() {
-	BoundedQueue<unsigned> queue { 1 };
+	Queue queue { 1 };
 
 	auto f = std::async(std::launch::async, [&](){
 		std::this_thread::sleep_for(std::chrono::milliseconds{50});
@@ -155,14 +168,131 @@ void test_blocked_consumer_unblocks() {
 	ASSERT_EQUAL(1, queue.pop());
 }
 
+void test_blocked_bulk_consumer_unblocks() {
+	BoundedQueue<unsigned> queue { 4 };
+	std::vector<unsigned> popped { }, expected { 1, 2, 3 };
+
+	auto f = std::async(std::launch::async, [&](){
+		std::this_thread::sleep_for(std::chrono::milliseconds{50});
+		queue.push_range(std::begin(expected), std::end(expected));
+	});
+
+	while (popped.size() < expected.size()) {
+		queue.pop_bulk(std::back_inserter(popped), expected.size());
+	}
+	ASSERT_EQUAL(expected, popped);
+}
+
+void test_pop_batch_collects_elements_pushed_one_by_one() {
+	BoundedQueue<unsigned> queue { 4 };
+	std::vector<unsigned> popped { }, expected { 1, 2, 3 };
+
+	auto f = std::async(std::launch::async, [&](){
+		for (auto ele : expected) {
+			std::this_thread::sleep_for(std::chrono::milliseconds{10});
+			queue.push(ele);
+		}
+	});
+
+	ASSERT_EQUAL(3, queue.pop_batch(std::back_inserter(popped), 3, std::chrono::seconds{5}));
+	ASSERT_EQUAL(expected, popped);
+}
+
+struct NotifyCountingConditionVariable {
+	template<typename LOCK, typename COND>
+	void wait(LOCK & lk, COND cond) { inner.wait(lk, cond); }
+	template<typename LOCK, typename REP, typename PER, typename COND>
+	bool wait_for(LOCK & lk, std::chrono::duration<REP, PER> const & timeout, COND cond) { return inner.wait_for(lk, timeout, cond); }
+	void notify_one() { ++notifications; inner.notify_one(); }
+	void notify_all() { ++notifications; inner.notify_all(); }
+
+	static std::atomic<unsigned> notifications;
+private:
+	std::condition_variable_any inner{};
+};
+std::atomic<unsigned> NotifyCountingConditionVariable::notifications{0};
+
+void test_push_notifies_only_blocked_consumer() {
+	BoundedQueue<unsigned, std::mutex, NotifyCountingConditionVariable> queue { 5 };
+	NotifyCountingConditionVariable::notifications = 0;
+
+	auto consumer = std::async(std::launch::async, [&](){
+		return queue.pop();
+	});
+	std::this_thread::sleep_for(std::chrono::milliseconds{50});
+	queue.push(1);
+	ASSERT_EQUAL(1, consumer.get());
+
+	queue.push(2);
+	queue.push(3);
+	queue.pop();
+	ASSERT_EQUAL(1, NotifyCountingConditionVariable::notifications.load());
+}
+
+using SpinParkQueue = BoundedQueue<unsigned, std::mutex, SpinParkConditionVariable<>>;
+
+void test_spin_park_timed_pop_times_out() {
+	SpinParkQueue queue { 1 };
+	unsigned result { };
+	auto const start = std::chrono::steady_clock::now();
+	ASSERT(!queue.try_pop_for(result, std::chrono::milliseconds{20}));
+	ASSERT(std::chrono::steady_clock::now() - start >= std::chrono::milliseconds{20});
+}
+
+void test_spin_park_timed_pop_is_woken_by_push() {
+	SpinParkQueue queue { 1 };
+	unsigned result { };
+
+	auto f = std::async(std::launch::async, [&](){
+		std::this_thread::sleep_for(std::chrono::milliseconds{50});
+		queue.push(1);
+	});
+
+	ASSERT(queue.try_pop_for(result, std::chrono::seconds{5}));
+	ASSERT_EQUAL(1, result);
+}
+
+struct FourLaneQueue : ShardedQueue<unsigned> {
+	explicit FourLaneQueue(size_type capacity) : ShardedQueue{capacity, 4} {}
+};
+
 cute::suite make_suite_bounded_queue_multi_threaded_suite() {
 	cute::suite s;
-	s.push_back(CUTE(test_one_producer_and_one_consumer));
-	s.push_back(CUTE(test_two_producers_and_one_consumer));
-	s.push_back(CUTE(test_one_producer_two_consumers));
-	s.push_back(CUTE(test_ten_producers_ten_consumers));
-	s.push_back(CUTE(test_blocked_produced_unblocks));
-	s.push_back(CUTE(test_blocked_consumer_unblocks));
+	s.push_back(CUTE(test_one_producer_and_one_consumer<BoundedQueue<unsigned>>));
+	s.push_back(CUTE(test_two_producers_and_one_consumer<BoundedQueue<unsigned>>));
+	s.push_back(CUTE(test_one_producer_two_consumers<BoundedQueue<unsigned>>));
+	s.push_back(CUTE(test_ten_producers_ten_consumers<BoundedQueue<unsigned>>));
+	s.push_back(CUTE(test_blocked_produced_unblocks<BoundedQueue<unsigned>>));
+	s.push_back(CUTE(test_blocked_consumer_unblocks<BoundedQueue<unsigned>>));
+	s.push_back(CUTE(test_blocked_bulk_consumer_unblocks));
+	s.push_back(CUTE(test_pop_batch_collects_elements_pushed_one_by_one));
+	s.push_back(CUTE(test_push_notifies_only_blocked_consumer));
+
+	s.push_back(CUTE(test_one_producer_and_one_consumer<MPMCQueue<unsigned>>));
+	s.push_back(CUTE(test_two_producers_and_one_consumer<MPMCQueue<unsigned>>));
+	s.push_back(CUTE(test_one_producer_two_consumers<MPMCQueue<unsigned>>));
+	s.push_back(CUTE(test_ten_producers_ten_consumers<MPMCQueue<unsigned>>));
+	s.push_back(CUTE(test_blocked_produced_unblocks<MPMCQueue<unsigned>>));
+	s.push_back(CUTE(test_blocked_consumer_unblocks<MPMCQueue<unsigned>>));
+
+	s.push_back(CUTE(test_one_producer_and_one_consumer<SpinParkQueue>));
+	s.push_back(CUTE(test_two_producers_and_one_consumer<SpinParkQueue>));
+	s.push_back(CUTE(test_one_producer_two_consumers<SpinParkQueue>));
+	s.push_back(CUTE(test_ten_producers_ten_consumers<SpinParkQueue>));
+	s.push_back(CUTE(test_blocked_produced_unblocks<SpinParkQueue>));
+	s.push_back(CUTE(test_blocked_consumer_unblocks<SpinParkQueue>));
+	s.push_back(CUTE(test_spin_park_timed_pop_times_out));
+	s.push_back(CUTE(test_spin_park_timed_pop_is_woken_by_push));
+
+	s.push_back(CUTE(test_one_producer_and_one_consumer<FourLaneQueue>));
+	s.push_back(CUTE(test_two_producers_and_one_consumer<FourLaneQueue>));
+	s.push_back(CUTE(test_one_producer_two_consumers<FourLaneQueue>));
+	s.push_back(CUTE(test_ten_producers_ten_consumers<FourLaneQueue>));
+	s.push_back(CUTE(test_blocked_produced_unblocks<FourLaneQueue>));
+	s.push_back(CUTE(test_blocked_consumer_unblocks<FourLaneQueue>));
+
+	s.push_back(CUTE(test_one_producer_and_one_consumer<SPSCQueue<unsigned>>));
+	s.push_back(CUTE(test_blocked_produced_unblocks<SPSCQueue<unsigned>>));
+	s.push_back(CUTE(test_blocked_consumer_unblocks<SPSCQueue<unsigned>>));
 	return s;
 }
-
@@ -2,6 +2,7 @@
 
 #include "cute.h"
 #include "BoundedQueue.h"
+#include <chrono>
 
 struct NonDefaultConstructible {
 	NonDefaultConstructible() = delete;
@@ -218,6 +219,46 @@ void test_move_assignment_deletes_previous_elements_upon_destruction() {
 }
 
 
+void test_emplace_neither_copies_nor_moves_element() {
+	BoundedQueue<NonDefaultConstructible> queue{5};
+
+	resetCounters();
+	queue.emplace(23);
+
+	ASSERT_EQUAL(0, NonDefaultConstructible::nOfCopyConstructions + NonDefaultConstructible::nOfMoveConstructions);
+}
+
+void test_optional_try_pop_moves_element_once() {
+	BoundedQueue<NonDefaultConstructible> queue{5};
+	queue.push(NonDefaultConstructible{23});
+
+	resetCounters();
+	auto popped = queue.try_pop();
+
+	ASSERT(popped.has_value());
+	ASSERT_EQUAL(1, NonDefaultConstructible::nOfMoveConstructions);
+}
+
+void test_optional_try_pop_must_not_move_assign() {
+	BoundedQueue<NonDefaultConstructible> queue{5};
+	queue.push(NonDefaultConstructible{23});
+
+	resetCounters();
+	auto popped = queue.try_pop();
+
+	ASSERT_EQUAL(0, NonDefaultConstructible::nOfMoveAssignments);
+}
+
+void test_optional_try_pop_until_moves_element_once() {
+	BoundedQueue<NonDefaultConstructible> queue{5};
+	queue.push(NonDefaultConstructible{23});
+
+	resetCounters();
+	auto popped = queue.try_pop_until(std::chrono::steady_clock::now() + std::chrono::milliseconds{1});
+
+	ASSERT(popped.has_value());
+	ASSERT_EQUAL(1, NonDefaultConstructible::nOfMoveConstructions);
+}
 
 cute::suite make_suite_bounded_queue_non_default_constructible_element_type_suite(){
 	cute::suite s;
@@ -236,6 +277,10 @@ cute::suite make_suite_bounded_queue_non_default_constructible_element_type_suit
 	s.push_back(CUTE(test_self_move_assignment_no_move_construction));
 	s.push_back(CUTE(test_copy_assignment_deletes_previous_elements));
 	s.push_back(CUTE(test_move_assignment_deletes_previous_elements_upon_destruction));
+	s.push_back(CUTE(test_emplace_neither_copies_nor_moves_element));
+	s.push_back(CUTE(test_optional_try_pop_moves_element_once));
+	s.push_back(CUTE(test_optional_try_pop_must_not_move_assign));
+	s.push_back(CUTE(test_optional_try_pop_until_moves_element_once));
 	return s;
 }
 
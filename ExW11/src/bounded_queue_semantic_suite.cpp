@@ -3,6 +3,7 @@
 #include "cute.h"
 #include "BoundedQueue.h"
 #include "MemoryOperationCounter.h"
+#include <chrono>
 
 
 
@@ -149,6 +150,63 @@ void test_capacity_is_moved_in_assignment() {
 	ASSERT(copy.full());
 }
 
+void test_queue_emplace_constructs_element_in_place() {
+	BoundedQueue<MemoryOperationCounter> queue { 1 };
+	MemoryOperationCounter expected { 1, 0, true };
+	queue.emplace(0u, 0u, true);
+	ASSERT_EQUAL(expected, queue.pop());
+}
+
+void test_queue_try_emplace_constructs_element_in_place() {
+	BoundedQueue<MemoryOperationCounter> queue { 1 };
+	MemoryOperationCounter expected { 1, 0, true };
+	ASSERT(queue.try_emplace(0u, 0u, true));
+	ASSERT_EQUAL(expected, queue.pop());
+}
+
+void test_queue_try_emplace_for_constructs_element_in_place() {
+	BoundedQueue<MemoryOperationCounter> queue { 1 };
+	MemoryOperationCounter expected { 1, 0, true };
+	ASSERT(queue.try_emplace_for(std::chrono::milliseconds { 1 }, 0u, 0u, true));
+	ASSERT_EQUAL(expected, queue.pop());
+}
+
+void test_queue_try_emplace_until_constructs_element_in_place() {
+	BoundedQueue<MemoryOperationCounter> queue { 1 };
+	MemoryOperationCounter expected { 1, 0, true };
+	ASSERT(queue.try_emplace_until(std::chrono::steady_clock::now() + std::chrono::milliseconds { 1 }, 0u, 0u, true));
+	ASSERT_EQUAL(expected, queue.pop());
+}
+
+void test_queue_try_emplace_on_full_queue_constructs_nothing() {
+	BoundedQueue<MemoryOperationCounter> queue { 1 };
+	MemoryOperationCounter counter { }, expected { 2, 0, true };
+	queue.push(std::move(counter));
+	ASSERT(!queue.try_emplace(5u, 5u, true));
+	ASSERT_EQUAL(expected, queue.pop());
+}
+
+void test_queue_try_push_moves_element() {
+	BoundedQueue<MemoryOperationCounter> queue { 1 };
+	MemoryOperationCounter counter { }, expected { 2, 0, true };
+	ASSERT(queue.try_push(std::move(counter)));
+	ASSERT_EQUAL(expected, queue.pop());
+}
+
+void test_queue_try_push_for_moves_element() {
+	BoundedQueue<MemoryOperationCounter> queue { 1 };
+	MemoryOperationCounter counter { }, expected { 2, 0, true };
+	ASSERT(queue.try_push_for(std::move(counter), std::chrono::milliseconds { 1 }));
+	ASSERT_EQUAL(expected, queue.pop());
+}
+
+void test_queue_try_push_for_copies_lvalue_element() {
+	BoundedQueue<MemoryOperationCounter> queue { 1 };
+	MemoryOperationCounter counter { }, expected { 1, 1, true };
+	ASSERT(queue.try_push_for(counter, std::chrono::milliseconds { 1 }));
+	ASSERT_EQUAL(expected, queue.pop());
+}
+
 cute::suite make_suite_bounded_queue_semantic_suite() {
 	cute::suite s;
 	s.push_back(CUTE(test_queue_push_moves_element));
@@ -165,6 +223,14 @@ cute::suite make_suite_bounded_queue_semantic_suite() {
 	s.push_back(CUTE(test_capacity_is_copied_in_assignment));
 	s.push_back(CUTE(test_capacity_is_moved_in_ctor));
 	s.push_back(CUTE(test_capacity_is_moved_in_assignment));
+	s.push_back(CUTE(test_queue_emplace_constructs_element_in_place));
+	s.push_back(CUTE(test_queue_try_emplace_constructs_element_in_place));
+	s.push_back(CUTE(test_queue_try_emplace_for_constructs_element_in_place));
+	s.push_back(CUTE(test_queue_try_emplace_until_constructs_element_in_place));
+	s.push_back(CUTE(test_queue_try_emplace_on_full_queue_constructs_nothing));
+	s.push_back(CUTE(test_queue_try_push_moves_element));
+	s.push_back(CUTE(test_queue_try_push_for_moves_element));
+	s.push_back(CUTE(test_queue_try_push_for_copies_lvalue_element));
 	return s;
 }
 
@@ -4,6 +4,7 @@
 #include "BoundedQueue.h"
 #include <boost/type_index.hpp>
 #include <chrono>
+#include <optional>
 
 
 void test_bounded_queue_value_type_is_value() {
@@ -118,6 +119,41 @@ void test_bounded_queue_type_of_try_pop_for_is_bool() {
 	ASSERT_EQUAL(expected_type.pretty_name(), pop_type.pretty_name());
 }
 
+void test_bounded_queue_type_of_emplace_is_void() {
+	BoundedQueue<int> queue { 15 };
+	auto emplace_type = boost::typeindex::type_id_with_cvr<decltype(queue.emplace(1))>();
+	auto expected_type = boost::typeindex::type_id_with_cvr<void>();
+	ASSERT_EQUAL(expected_type.pretty_name(), emplace_type.pretty_name());
+}
+
+void test_bounded_queue_type_of_try_emplace_is_bool() {
+	BoundedQueue<int> queue { 15 };
+	auto emplace_type = boost::typeindex::type_id_with_cvr<decltype(queue.try_emplace(1))>();
+	auto expected_type = boost::typeindex::type_id_with_cvr<bool>();
+	ASSERT_EQUAL(expected_type.pretty_name(), emplace_type.pretty_name());
+}
+
+void test_bounded_queue_type_of_try_emplace_for_is_bool() {
+	BoundedQueue<int> queue { 15 };
+	auto emplace_type = boost::typeindex::type_id_with_cvr<decltype(queue.try_emplace_for(std::chrono::seconds{1}, 1))>();
+	auto expected_type = boost::typeindex::type_id_with_cvr<bool>();
+	ASSERT_EQUAL(expected_type.pretty_name(), emplace_type.pretty_name());
+}
+
+void test_bounded_queue_type_of_try_pop_without_argument_is_optional() {
+	BoundedQueue<int> queue { 15 };
+	auto pop_type = boost::typeindex::type_id_with_cvr<decltype(queue.try_pop())>();
+	auto expected_type = boost::typeindex::type_id_with_cvr<std::optional<int>>();
+	ASSERT_EQUAL(expected_type.pretty_name(), pop_type.pretty_name());
+}
+
+void test_bounded_queue_type_of_try_pop_until_without_element_is_optional() {
+	BoundedQueue<int> queue { 15 };
+	auto pop_type = boost::typeindex::type_id_with_cvr<decltype(queue.try_pop_until(std::chrono::steady_clock::now()))>();
+	auto expected_type = boost::typeindex::type_id_with_cvr<std::optional<int>>();
+	ASSERT_EQUAL(expected_type.pretty_name(), pop_type.pretty_name());
+}
+
 cute::suite make_suite_bounded_queue_signatures_suite() {
 	cute::suite s;
 	s.push_back(CUTE(test_bounded_queue_value_type_is_value));
@@ -136,6 +172,11 @@ cute::suite make_suite_bounded_queue_signatures_suite() {
 	s.push_back(CUTE(test_bounded_queue_type_of_try_pop_is_bool));
 	s.push_back(CUTE(test_bounded_queue_type_of_try_push_for_is_bool));
 	s.push_back(CUTE(test_bounded_queue_type_of_try_pop_for_is_bool));
+	s.push_back(CUTE(test_bounded_queue_type_of_emplace_is_void));
+	s.push_back(CUTE(test_bounded_queue_type_of_try_emplace_is_bool));
+	s.push_back(CUTE(test_bounded_queue_type_of_try_emplace_for_is_bool));
+	s.push_back(CUTE(test_bounded_queue_type_of_try_pop_without_argument_is_optional));
+	s.push_back(CUTE(test_bounded_queue_type_of_try_pop_until_without_element_is_optional));
 	return s;
 }
 
@@ -0,0 +1,191 @@
+#include "broadcast_ring_suite.h"
+
+#include "cute.h"
+#include "BroadcastRing.h"
+#include "times_literal.hpp"
+#include <cstdint>
+#include <future>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace times::literal;
+using namespace std::chrono_literals;
+
+struct BroadcastMessage {
+	BroadcastMessage(int value) : value{value} {}
+	BroadcastMessage(BroadcastMessage const & other) : value{other.value} { ++copies; }
+
+	int value;
+	static unsigned copies;
+};
+unsigned BroadcastMessage::copies{0};
+
+void test_broadcast_ring_without_readers_throws() {
+	ASSERT_THROWS((BroadcastRing<int>{4, 0}), std::invalid_argument);
+}
+
+void test_broadcast_ring_capacity_zero_throws() {
+	ASSERT_THROWS((BroadcastRing<int>{0, 1}), std::invalid_argument);
+}
+
+void test_broadcast_ring_unknown_reader_throws() {
+	BroadcastRing<int> ring{4, 2};
+	ASSERT_THROWS(ring.reader(2), std::out_of_range);
+}
+
+void test_every_reader_sees_every_element() {
+	BroadcastRing<int> ring{8, 2};
+	for (int i : {1, 2, 3}) ring.publish(i);
+	for (std::size_t r = 0; r < ring.readers(); ++r) {
+		auto reader = ring.reader(r);
+		auto const batch = reader.try_claim();
+		ASSERT_EQUAL(3, batch.size());
+		ASSERT_EQUAL(1, batch[0]);
+		ASSERT_EQUAL(3, batch[2]);
+		reader.release(batch);
+	}
+}
+
+void test_broadcast_ring_does_not_copy_per_reader() {
+	BroadcastRing<BroadcastMessage> ring{4, 3};
+	BroadcastMessage::copies = 0;
+	ring.emplace(42);
+	for (std::size_t r = 0; r < ring.readers(); ++r) {
+		auto reader = ring.reader(r);
+		int seen{0};
+		reader.consume([&](BroadcastMessage const & message){ seen = message.value; });
+		ASSERT_EQUAL(42, seen);
+	}
+	ASSERT_EQUAL(0, BroadcastMessage::copies);
+}
+
+struct alignas(64) BroadcastOverAligned {
+	BroadcastOverAligned(int value) : value{value} { misaligned |= reinterpret_cast<std::uintptr_t>(this) % alignof(BroadcastOverAligned); }
+	int value;
+	static bool misaligned;
+};
+bool BroadcastOverAligned::misaligned{false};
+
+void test_broadcast_ring_aligns_over_aligned_elements() {
+	BroadcastOverAligned::misaligned = false;
+	std::vector<std::unique_ptr<BroadcastRing<BroadcastOverAligned>>> rings{};
+	for (std::size_t capacity = 1; capacity <= 8; ++capacity) {
+		auto & ring = *rings.emplace_back(std::make_unique<BroadcastRing<BroadcastOverAligned>>(capacity, 1));
+		ring.emplace(1);
+		auto reader = ring.reader(0);
+		int sum{0};
+		reader.consume([&](BroadcastOverAligned const & element){ sum += element.value; });
+		ASSERT_EQUAL(1, sum);
+	}
+	ASSERT(!BroadcastOverAligned::misaligned);
+}
+
+void test_claim_is_limited_to_max_elements() {
+	BroadcastRing<int> ring{8, 1};
+	for (int i : {1, 2, 3, 4, 5}) ring.publish(i);
+	auto reader = ring.reader(0);
+	auto const first = reader.try_claim(2);
+	auto const second = reader.try_claim();
+	ASSERT_EQUAL(2, first.size());
+	ASSERT_EQUAL(3, second.size());
+	ASSERT_EQUAL(3, second[0]);
+	ASSERT_EQUAL(0, reader.available());
+}
+
+void test_slowest_reader_gates_the_producer() {
+	BroadcastRing<int> ring{2, 2};
+	auto fast = ring.reader(0);
+	ASSERT(ring.try_publish(1));
+	ASSERT(ring.try_publish(2));
+	fast.release(fast.try_claim());
+	ASSERT(!ring.try_publish(3));
+
+	auto slow = ring.reader(1);
+	slow.release(slow.try_claim(1));
+	ASSERT(ring.try_publish(3));
+	ASSERT(!ring.try_publish(4));
+}
+
+void test_reused_slots_destroy_their_previous_element() {
+	auto counter = std::make_shared<int>(0);
+	{
+		BroadcastRing<std::shared_ptr<int>> ring{2, 1};
+		auto reader = ring.reader(0);
+		5_times([&]{
+			ring.publish(counter);
+			reader.consume([](std::shared_ptr<int> const &){});
+		});
+		ASSERT_EQUAL(3, counter.use_count());
+	}
+	ASSERT_EQUAL(1, counter.use_count());
+}
+
+void test_blocked_reader_unblocks_on_publish() {
+	BroadcastRing<int> ring{4, 1};
+	auto f = std::async(std::launch::async, [&]{
+		std::this_thread::sleep_for(50ms);
+		ring.publish(23);
+	});
+	auto reader = ring.reader(0);
+	auto const batch = reader.claim();
+	ASSERT_EQUAL(1, batch.size());
+	ASSERT_EQUAL(23, batch[0]);
+}
+
+void test_closed_broadcast_ring_drains_then_returns_empty_batch() {
+	BroadcastRing<int> ring{4, 1};
+	ring.publish(1);
+	ring.close();
+	ASSERT(ring.is_closed());
+	ASSERT_THROWS(ring.publish(2), closed_queue);
+	auto reader = ring.reader(0);
+	ASSERT_EQUAL(1, reader.consume([](int){}));
+	ASSERT_EQUAL(0, reader.consume([](int){}));
+}
+
+void test_close_wakes_blocked_reader() {
+	BroadcastRing<int> ring{4, 1};
+	auto reader = ring.reader(0);
+	auto consumed = std::async(std::launch::async, [&]{ return reader.consume([](int){}); });
+	std::this_thread::sleep_for(50ms);
+	ring.close();
+	ASSERT_EQUAL(0, consumed.get());
+}
+
+void test_concurrent_readers_each_see_the_whole_stream_in_order() {
+	unsigned const elements{50000};
+	BroadcastRing<unsigned> ring{64, 3};
+	std::vector<std::future<bool>> readers{};
+	for (std::size_t r = 0; r < ring.readers(); ++r) {
+		readers.push_back(std::async(std::launch::async, [&ring, r]{
+			auto reader = ring.reader(r);
+			unsigned expected{0};
+			bool inOrder{true};
+			while (reader.consume([&](unsigned ele){ inOrder = inOrder && ele == expected++; }, 16)) {}
+			return inOrder && expected == elements;
+		}));
+	}
+	for (unsigned i = 0; i < elements; ++i) ring.publish(i);
+	ring.close();
+	for (auto & reader : readers) ASSERT(reader.get());
+}
+
+cute::suite make_suite_broadcast_ring_suite() {
+	cute::suite s;
+	s.push_back(CUTE(test_broadcast_ring_without_readers_throws));
+	s.push_back(CUTE(test_broadcast_ring_capacity_zero_throws));
+	s.push_back(CUTE(test_broadcast_ring_unknown_reader_throws));
+	s.push_back(CUTE(test_every_reader_sees_every_element));
+	s.push_back(CUTE(test_broadcast_ring_does_not_copy_per_reader));
+	s.push_back(CUTE(test_broadcast_ring_aligns_over_aligned_elements));
+	s.push_back(CUTE(test_claim_is_limited_to_max_elements));
+	s.push_back(CUTE(test_slowest_reader_gates_the_producer));
+	s.push_back(CUTE(test_reused_slots_destroy_their_previous_element));
+	s.push_back(CUTE(test_blocked_reader_unblocks_on_publish));
+	s.push_back(CUTE(test_closed_broadcast_ring_drains_then_returns_empty_batch));
+	s.push_back(CUTE(test_close_wakes_blocked_reader));
+	s.push_back(CUTE(test_concurrent_readers_each_see_the_whole_stream_in_order));
+	return s;
+}
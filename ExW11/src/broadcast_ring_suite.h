@@ -0,0 +1,8 @@
+#ifndef BROADCAST_RING_SUITE_H_
+#define BROADCAST_RING_SUITE_H_
+
+#include "cute_suite.h"
+
+extern cute::suite make_suite_broadcast_ring_suite();
+
+#endif
@@ -0,0 +1,223 @@
+#include "coroutine_suite.h"
+
+#include "cute.h"
+#include "BoundedQueue.h"
+#include "ThreadPool.h"
+#include "times_literal.hpp"
+#include "WaitSignal.h"
+#include <atomic>
+#include <coroutine>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <future>
+#include <optional>
+#include <thread>
+#include <vector>
+
+using namespace times::literal;
+using namespace std::chrono_literals;
+
+struct Detached {
+	struct promise_type {
+		Detached get_return_object() noexcept { return {}; }
+		std::suspend_never initial_suspend() noexcept { return {}; }
+		std::suspend_never final_suspend() noexcept { return {}; }
+		void return_void() noexcept {}
+		void unhandled_exception() { std::terminate(); }
+	};
+};
+
+struct ManualExecutor {
+	template<typename F>
+	void post(F && f) { tasks.emplace_back(std::forward<F>(f)); }
+	void run() {
+		while (!tasks.empty()) {
+			auto task = std::move(tasks.front());
+			tasks.pop_front();
+			task();
+		}
+	}
+	std::deque<std::function<void()>> tasks{};
+};
+
+template<typename Executor>
+Detached popInto(BoundedQueue<int> & queue, Executor & executor, std::optional<int> & result) {
+	result = co_await queue.co_pop(executor);
+}
+
+Detached popOrNoteClosed(BoundedQueue<int> & queue, ManualExecutor & executor, bool & closed) {
+	try {
+		co_await queue.co_pop(executor);
+	} catch (closed_queue const &) {
+		closed = true;
+	}
+}
+
+Detached pushThenNote(BoundedQueue<int> & queue, ManualExecutor & executor, int value, bool & pushed) {
+	co_await queue.co_push(value, executor);
+	pushed = true;
+}
+
+void test_co_pop_on_non_empty_queue_does_not_suspend() {
+	BoundedQueue<int> queue{5};
+	ManualExecutor executor{};
+	std::optional<int> result{};
+	queue.push(23);
+	popInto(queue, executor, result);
+	ASSERT_EQUAL(23, result.value());
+	ASSERT(executor.tasks.empty());
+}
+
+void test_co_pop_on_empty_queue_suspends_until_push() {
+	BoundedQueue<int> queue{5};
+	ManualExecutor executor{};
+	std::optional<int> result{};
+	popInto(queue, executor, result);
+	ASSERT(!result);
+
+	queue.push(23);
+	ASSERT(!result);
+	ASSERT(queue.empty());
+	executor.run();
+	ASSERT_EQUAL(23, result.value());
+}
+
+void test_co_pop_resumes_suspended_coroutines_in_fifo_order() {
+	BoundedQueue<int> queue{5};
+	ManualExecutor executor{};
+	std::optional<int> first{}, second{};
+	popInto(queue, executor, first);
+	popInto(queue, executor, second);
+	queue.push(1);
+	queue.push(2);
+	executor.run();
+	ASSERT_EQUAL(1, first.value());
+	ASSERT_EQUAL(2, second.value());
+}
+
+void test_push_range_hands_off_to_suspended_coroutines() {
+	BoundedQueue<int> queue{5};
+	ManualExecutor executor{};
+	std::optional<int> first{}, second{};
+	std::vector<int> const values{1, 2, 3};
+	popInto(queue, executor, first);
+	popInto(queue, executor, second);
+	queue.push_range(std::begin(values), std::end(values));
+	executor.run();
+	ASSERT_EQUAL(1, first.value());
+	ASSERT_EQUAL(2, second.value());
+	ASSERT_EQUAL(3, queue.pop());
+}
+
+void test_co_push_on_full_queue_suspends_until_pop() {
+	BoundedQueue<int> queue{1};
+	ManualExecutor executor{};
+	bool pushed{false};
+	queue.push(1);
+	pushThenNote(queue, executor, 2, pushed);
+	ASSERT(!pushed);
+
+	ASSERT_EQUAL(1, queue.pop());
+	ASSERT(queue.full());
+	executor.run();
+	ASSERT(pushed);
+	ASSERT_EQUAL(2, queue.pop());
+}
+
+void test_co_push_on_queue_with_space_does_not_suspend() {
+	BoundedQueue<int> queue{2};
+	ManualExecutor executor{};
+	bool pushed{false};
+	pushThenNote(queue, executor, 2, pushed);
+	ASSERT(pushed);
+	ASSERT_EQUAL(2, queue.pop());
+}
+
+void test_close_resumes_suspended_coroutines_with_closed_queue() {
+	BoundedQueue<int> queue{5};
+	ManualExecutor executor{};
+	bool closed{false};
+	popOrNoteClosed(queue, executor, closed);
+	queue.close();
+	executor.run();
+	ASSERT(closed);
+}
+
+Detached consumeOne(BoundedQueue<unsigned> & queue, ThreadPool<> & pool, std::atomic<unsigned> & sum, std::atomic<unsigned> & done) {
+	sum += co_await queue.co_pop(pool);
+	++done;
+}
+
+void test_thousand_coroutine_consumers_on_two_threads() {
+	unsigned const nOfConsumers = 1000;
+	BoundedQueue<unsigned> queue{16};
+	std::atomic<unsigned> sum{0}, done{0};
+	{
+		ThreadPool<> pool{2, nOfConsumers};
+		for (unsigned i = 0; i < nOfConsumers; ++i) consumeOne(queue, pool, sum, done);
+		for (unsigned i = 1; i <= nOfConsumers; ++i) queue.push(i);
+		auto const deadline = std::chrono::steady_clock::now() + 5s;
+		while (done < nOfConsumers && std::chrono::steady_clock::now() < deadline) std::this_thread::sleep_for(1ms);
+	}
+	ASSERT_EQUAL(nOfConsumers, done.load());
+	ASSERT_EQUAL(nOfConsumers * (nOfConsumers + 1) / 2, sum.load());
+}
+
+void test_co_pop_resumes_inline_when_executor_is_shut_down() {
+	BoundedQueue<int> queue{5};
+	ThreadPool<> pool{1};
+	std::optional<int> result{};
+	popInto(queue, pool, result);
+	pool.shutdown();
+	queue.push(42);
+	ASSERT_EQUAL(42, result.value());
+}
+
+void test_co_pop_resumes_inline_when_executor_is_full() {
+	BoundedQueue<int> queue{5};
+	ThreadPool<> pool{1, 1};
+	std::promise<void> release{};
+	std::shared_future<void> released{release.get_future()};
+	std::promise<void> started{};
+	pool.post([&started, released]{ started.set_value(); released.wait(); });
+	started.get_future().wait();
+	pool.post([]{});
+	std::optional<int> result{};
+	popInto(queue, pool, result);
+	queue.push(42);
+	release.set_value();
+	ASSERT_EQUAL(42, result.value());
+}
+
+void test_pop_admitting_suspended_co_push_notifies_subscribers() {
+	BoundedQueue<int> queue{1};
+	ManualExecutor executor{};
+	WaitSignal signal{};
+	queue.subscribe(signal);
+	queue.push(1);
+	bool pushed{false};
+	pushThenNote(queue, executor, 2, pushed);
+	auto const seen = signal.epoch();
+	ASSERT_EQUAL(1, queue.pop());
+	ASSERT_NOT_EQUAL_TO(seen, signal.epoch());
+	executor.run();
+	ASSERT(pushed);
+	queue.unsubscribe(signal);
+}
+
+cute::suite make_suite_coroutine_suite() {
+	cute::suite s;
+	s.push_back(CUTE(test_co_pop_on_non_empty_queue_does_not_suspend));
+	s.push_back(CUTE(test_co_pop_on_empty_queue_suspends_until_push));
+	s.push_back(CUTE(test_co_pop_resumes_suspended_coroutines_in_fifo_order));
+	s.push_back(CUTE(test_push_range_hands_off_to_suspended_coroutines));
+	s.push_back(CUTE(test_co_push_on_full_queue_suspends_until_pop));
+	s.push_back(CUTE(test_co_push_on_queue_with_space_does_not_suspend));
+	s.push_back(CUTE(test_close_resumes_suspended_coroutines_with_closed_queue));
+	s.push_back(CUTE(test_thousand_coroutine_consumers_on_two_threads));
+	s.push_back(CUTE(test_co_pop_resumes_inline_when_executor_is_shut_down));
+	s.push_back(CUTE(test_co_pop_resumes_inline_when_executor_is_full));
+	s.push_back(CUTE(test_pop_admitting_suspended_co_push_notifies_subscribers));
+	return s;
+}
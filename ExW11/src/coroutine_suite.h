@@ -0,0 +1,8 @@
+#ifndef COROUTINE_SUITE_H_
+#define COROUTINE_SUITE_H_
+
+#include "cute_suite.h"
+
+extern cute::suite make_suite_coroutine_suite();
+
+#endif
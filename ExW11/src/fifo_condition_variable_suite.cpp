@@ -0,0 +1,131 @@
+#include "fifo_condition_variable_suite.h"
+
+#include "cute.h"
+#include "BoundedQueue.h"
+#include "FifoConditionVariable.h"
+#include <future>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace std::chrono_literals;
+
+void test_fair_queue_serves_blocked_producers_in_arrival_order() {
+	FairBoundedQueue<int> queue{1};
+	queue.push(0);
+	std::vector<std::future<void>> producers{};
+	for (int i = 1; i <= 3; ++i) {
+		producers.push_back(std::async(std::launch::async, [&queue, i]{ queue.push(i); }));
+		std::this_thread::sleep_for(30ms);
+	}
+	std::vector<int> popped{}, expected{0, 1, 2, 3};
+	for (int i = 0; i < 4; ++i) popped.push_back(queue.pop());
+	ASSERT_EQUAL(expected, popped);
+}
+
+void test_fair_queue_serves_blocked_consumers_in_arrival_order() {
+	FairBoundedQueue<int> queue{5};
+	std::vector<std::future<int>> consumers{};
+	for (int i = 0; i < 3; ++i) {
+		consumers.push_back(std::async(std::launch::async, [&queue]{ return queue.pop(); }));
+		std::this_thread::sleep_for(30ms);
+	}
+	for (int i = 1; i <= 3; ++i) {
+		queue.push(i);
+		ASSERT_EQUAL(i, consumers[i - 1].get());
+	}
+}
+
+void test_fifo_condition_variable_newcomer_does_not_barge() {
+	std::mutex mx{};
+	FifoConditionVariable cv{};
+	bool ready{false};
+	std::vector<char> order{};
+	auto const waitFor = [&](char const name){
+		std::unique_lock<std::mutex> lk{mx};
+		cv.wait(lk, [&]{ return ready; });
+		order.push_back(name);
+	};
+
+	auto first = std::async(std::launch::async, waitFor, 'A');
+	std::this_thread::sleep_for(30ms);
+	{
+		std::lock_guard<std::mutex> lk{mx};
+		ready = true;
+	}
+	auto newcomer = std::async(std::launch::async, waitFor, 'B');
+	ASSERT(newcomer.wait_for(30ms) == std::future_status::timeout);
+
+	cv.notify_one();
+	first.get();
+	newcomer.get();
+	std::vector<char> const expected{'A', 'B'};
+	ASSERT_EQUAL(expected, order);
+}
+
+void test_fifo_condition_variable_timed_out_waiter_leaves_the_line() {
+	std::mutex mx{};
+	FifoConditionVariable cv{};
+	bool ready{false};
+	auto timed = std::async(std::launch::async, [&]{
+		std::unique_lock<std::mutex> lk{mx};
+		return cv.wait_for(lk, 50ms, [&]{ return ready; });
+	});
+	std::this_thread::sleep_for(10ms);
+	auto patient = std::async(std::launch::async, [&]{
+		std::unique_lock<std::mutex> lk{mx};
+		cv.wait(lk, [&]{ return ready; });
+	});
+	ASSERT(!timed.get());
+	{
+		std::lock_guard<std::mutex> lk{mx};
+		ready = true;
+	}
+	cv.notify_one();
+	ASSERT(patient.wait_for(1s) == std::future_status::ready);
+
+	// first in line and the condition holds at the deadline, even though nobody notified
+	bool late{false};
+	auto first = std::async(std::launch::async, [&]{
+		std::unique_lock<std::mutex> lk{mx};
+		return cv.wait_for(lk, 50ms, [&]{ return late; });
+	});
+	std::this_thread::sleep_for(10ms);
+	{
+		std::lock_guard<std::mutex> lk{mx};
+		late = true;
+	}
+	ASSERT(first.get());
+}
+
+void test_fair_queue_producers_and_consumers_see_every_element_once() {
+	unsigned const perProducer{5000};
+	FairBoundedQueue<unsigned> queue{8};
+	std::vector<std::future<unsigned long long>> consumers{};
+	std::vector<std::future<void>> producers{};
+	for (unsigned c = 0; c < 4; ++c) {
+		consumers.push_back(std::async(std::launch::async, [&]{
+			unsigned long long sum{0};
+			for (unsigned i = 0; i < perProducer; ++i) sum += queue.pop();
+			return sum;
+		}));
+	}
+	for (unsigned p = 0; p < 4; ++p) {
+		producers.push_back(std::async(std::launch::async, [&]{
+			for (unsigned i = 1; i <= perProducer; ++i) queue.push(i);
+		}));
+	}
+	unsigned long long sum{0};
+	for (auto & consumer : consumers) sum += consumer.get();
+	ASSERT_EQUAL(4ull * perProducer * (perProducer + 1) / 2, sum);
+}
+
+cute::suite make_suite_fifo_condition_variable_suite() {
+	cute::suite s;
+	s.push_back(CUTE(test_fair_queue_serves_blocked_producers_in_arrival_order));
+	s.push_back(CUTE(test_fair_queue_serves_blocked_consumers_in_arrival_order));
+	s.push_back(CUTE(test_fifo_condition_variable_newcomer_does_not_barge));
+	s.push_back(CUTE(test_fifo_condition_variable_timed_out_waiter_leaves_the_line));
+	s.push_back(CUTE(test_fair_queue_producers_and_consumers_see_every_element_once));
+	return s;
+}
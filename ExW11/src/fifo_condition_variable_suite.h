@@ -0,0 +1,8 @@
+#ifndef FIFO_CONDITION_VARIABLE_SUITE_H_
+#define FIFO_CONDITION_VARIABLE_SUITE_H_
+
+#include "cute_suite.h"
+
+extern cute::suite make_suite_fifo_condition_variable_suite();
+
+#endif
@@ -0,0 +1,80 @@
+#include "huge_page_allocator_suite.h"
+
+#include "cute.h"
+#include "BoundedQueue.h"
+#include "HugePageAllocator.h"
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+
+template<typename T>
+using HugePageQueue = BoundedQueue<T, std::mutex, std::condition_variable, ModuloCapacity, HugePageAllocator<T>>;
+
+bool alignedTo(void const * memory, std::size_t alignment) {
+	return reinterpret_cast<std::uintptr_t>(memory) % alignment == 0;
+}
+
+void test_small_allocation_is_page_aligned() {
+	HugePageAllocator<int> allocator{};
+	auto const memory = allocator.allocate(10);
+	ASSERT(alignedTo(memory, HugePageAllocator<int>::page_size));
+	memory[9] = 42;
+	ASSERT_EQUAL(42, memory[9]);
+	allocator.deallocate(memory, 10);
+}
+
+void test_large_allocation_is_huge_page_aligned() {
+	HugePageAllocator<std::uint64_t> allocator{};
+	std::size_t const n{HugePageAllocator<std::uint64_t>::huge_page_size / sizeof(std::uint64_t) + 1};
+	auto const memory = allocator.allocate(n);
+	ASSERT(alignedTo(memory, HugePageAllocator<std::uint64_t>::huge_page_size));
+	memory[0] = 1;
+	memory[n - 1] = 2;
+	ASSERT_EQUAL(3, memory[0] + memory[n - 1]);
+	allocator.deallocate(memory, n);
+}
+
+void test_prefaulted_allocation_is_zeroed() {
+	HugePageAllocator<int> allocator{HugePagePlacement::prefault};
+	std::size_t const n{HugePageAllocator<int>::huge_page_size / sizeof(int)};
+	auto const memory = allocator.allocate(n);
+	ASSERT_EQUAL(0, memory[0]);
+	ASSERT_EQUAL(0, memory[n - 1]);
+	allocator.deallocate(memory, n);
+}
+
+void test_rebound_allocator_keeps_placement_and_compares_equal() {
+	HugePageAllocator<int> const allocator{HugePagePlacement::local_node};
+	HugePageAllocator<double> const rebound{allocator};
+	ASSERT(HugePagePlacement::local_node == rebound.placement());
+	ASSERT(allocator == rebound);
+}
+
+void test_queue_on_huge_pages_keeps_fifo_order() {
+	for (auto placement : {HugePagePlacement::on_first_touch, HugePagePlacement::prefault, HugePagePlacement::local_node}) {
+		std::size_t const capacity{1 << 20};
+		HugePageQueue<unsigned> queue{capacity, HugePageAllocator<unsigned>{placement}};
+		for (unsigned i = 0; i < capacity; ++i) queue.push(i);
+		ASSERT(queue.full());
+		for (unsigned i = 0; i < capacity; ++i) ASSERT_EQUAL(i, queue.pop());
+	}
+}
+
+void test_copy_of_queue_on_huge_pages_keeps_placement() {
+	HugePageQueue<int> queue{8, HugePageAllocator<int>{HugePagePlacement::prefault}};
+	queue.push(1);
+	HugePageQueue<int> copy{queue};
+	ASSERT(HugePagePlacement::prefault == copy.get_allocator().placement());
+	ASSERT_EQUAL(1, copy.pop());
+}
+
+cute::suite make_suite_huge_page_allocator_suite() {
+	cute::suite s;
+	s.push_back(CUTE(test_small_allocation_is_page_aligned));
+	s.push_back(CUTE(test_large_allocation_is_huge_page_aligned));
+	s.push_back(CUTE(test_prefaulted_allocation_is_zeroed));
+	s.push_back(CUTE(test_rebound_allocator_keeps_placement_and_compares_equal));
+	s.push_back(CUTE(test_queue_on_huge_pages_keeps_fifo_order));
+	s.push_back(CUTE(test_copy_of_queue_on_huge_pages_keeps_placement));
+	return s;
+}
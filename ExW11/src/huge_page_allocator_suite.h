@@ -0,0 +1,8 @@
+#ifndef HUGE_PAGE_ALLOCATOR_SUITE_H_
+#define HUGE_PAGE_ALLOCATOR_SUITE_H_
+
+#include "cute_suite.h"
+
+extern cute::suite make_suite_huge_page_allocator_suite();
+
+#endif
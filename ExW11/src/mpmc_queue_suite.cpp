@@ -0,0 +1,165 @@
+#include "mpmc_queue_suite.h"
+
+#include "cute.h"
+#include "MPMCQueue.h"
+#include "MemoryOperationCounter.h"
+#include "times_literal.hpp"
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+using namespace times::literal;
+using namespace std::chrono_literals;
+
+void test_mpmc_constructor_for_capacity_zero_throws() {
+	ASSERT_THROWS(MPMCQueue<int> queue{0}, std::invalid_argument);
+}
+
+void test_mpmc_new_queue_is_empty() {
+	MPMCQueue<int> const queue{5};
+	ASSERT(queue.empty());
+	ASSERT_EQUAL(0, queue.size());
+}
+
+void test_mpmc_queue_is_full_after_capacity_pushs() {
+	MPMCQueue<int> queue{3};
+	3_times([&]{ queue.push(1); });
+	ASSERT(queue.full());
+}
+
+void test_mpmc_pop_in_sequence_of_push() {
+	MPMCQueue<int> queue{5};
+	queue.push(1);
+	queue.push(2);
+	queue.push(3);
+	ASSERT_EQUAL(1, queue.pop());
+	ASSERT_EQUAL(2, queue.pop());
+	ASSERT_EQUAL(3, queue.pop());
+}
+
+void test_mpmc_capacity_one_wraps_around() {
+	MPMCQueue<int> queue{1};
+	for (int i = 0; i < 10; ++i) {
+		ASSERT(queue.try_push(i));
+		ASSERT(!queue.try_push(i));
+		int popped{};
+		ASSERT(queue.try_pop(popped));
+		ASSERT_EQUAL(i, popped);
+	}
+	ASSERT(queue.empty());
+}
+
+void test_mpmc_empty_queue_returns_false_on_try_pop() {
+	MPMCQueue<int> queue{2};
+	int val{};
+	ASSERT(!queue.try_pop(val));
+}
+
+void test_mpmc_empty_queue_returns_false_on_try_pop_for() {
+	MPMCQueue<int> queue{2};
+	int val{};
+	ASSERT(!queue.try_pop_for(val, 1ms));
+}
+
+void test_mpmc_full_queue_returns_false_on_try_push_for() {
+	MPMCQueue<int> queue{1};
+	queue.push(1);
+	ASSERT(!queue.try_push_for(2, 1ms));
+}
+
+void test_mpmc_push_moves_element() {
+	MPMCQueue<MemoryOperationCounter> queue{1};
+	MemoryOperationCounter counter{}, expected{2, 0, true};
+	queue.push(std::move(counter));
+	ASSERT_EQUAL(expected, queue.pop());
+}
+
+struct MPMCDestructionCounter {
+	static unsigned destructions;
+	~MPMCDestructionCounter() { ++destructions; }
+};
+unsigned MPMCDestructionCounter::destructions{0};
+
+void test_mpmc_remaining_elements_are_destroyed() {
+	{
+		MPMCQueue<MPMCDestructionCounter> queue{4};
+		5_times([&]{ queue.push(MPMCDestructionCounter{}); queue.pop(); });
+		3_times([&]{ queue.push(MPMCDestructionCounter{}); });
+		MPMCDestructionCounter::destructions = 0;
+	}
+	ASSERT_EQUAL(3, MPMCDestructionCounter::destructions);
+}
+
+void test_mpmc_power_of_two_queue_wraps_around() {
+	MPMCQueue<int, PowerOfTwoCapacity> queue{3};
+	ASSERT_EQUAL(4, queue.capacity());
+	for (int i = 0; i < 10; ++i) {
+		queue.push(i);
+		queue.push(i + 1);
+		ASSERT_EQUAL(i, queue.pop());
+		ASSERT_EQUAL(i + 1, queue.pop());
+	}
+}
+
+struct alignas(64) MPMCOverAligned {
+	MPMCOverAligned(int value) : value{value} { misaligned |= reinterpret_cast<std::uintptr_t>(this) % alignof(MPMCOverAligned); }
+	MPMCOverAligned(MPMCOverAligned && other) noexcept : MPMCOverAligned{other.value} {}
+	MPMCOverAligned & operator=(MPMCOverAligned &&) noexcept = default;
+	int value;
+	static bool misaligned;
+};
+bool MPMCOverAligned::misaligned{false};
+
+void test_mpmc_aligns_over_aligned_elements() {
+	MPMCOverAligned::misaligned = false;
+	std::vector<std::unique_ptr<MPMCQueue<MPMCOverAligned>>> queues{};
+	for (std::size_t capacity = 1; capacity <= 8; ++capacity) {
+		auto & queue = *queues.emplace_back(std::make_unique<MPMCQueue<MPMCOverAligned>>(capacity));
+		queue.push(MPMCOverAligned{1});
+		ASSERT_EQUAL(1, queue.pop().value);
+	}
+	ASSERT(!MPMCOverAligned::misaligned);
+}
+
+struct MPMCThrowingCopy {
+	static bool throws;
+	int value{};
+	explicit MPMCThrowingCopy(int value) : value{value} {}
+	MPMCThrowingCopy(MPMCThrowingCopy const & other) : value{other.value} {
+		if (throws) throw std::runtime_error{"copy failed"};
+	}
+	MPMCThrowingCopy(MPMCThrowingCopy &&) noexcept = default;
+	MPMCThrowingCopy & operator=(MPMCThrowingCopy &&) noexcept = default;
+};
+bool MPMCThrowingCopy::throws{false};
+
+void test_mpmc_throwing_copy_does_not_claim_a_slot() {
+	MPMCQueue<MPMCThrowingCopy> queue{2};
+	MPMCThrowingCopy const element{1};
+	MPMCThrowingCopy::throws = true;
+	ASSERT_THROWS(queue.push(element), std::runtime_error);
+	ASSERT_THROWS(queue.try_push(element), std::runtime_error);
+	MPMCThrowingCopy::throws = false;
+	ASSERT(queue.empty());
+	queue.push(element);
+	ASSERT_EQUAL(1, queue.pop().value);
+}
+
+cute::suite make_suite_mpmc_queue_suite() {
+	cute::suite s;
+	s.push_back(CUTE(test_mpmc_constructor_for_capacity_zero_throws));
+	s.push_back(CUTE(test_mpmc_new_queue_is_empty));
+	s.push_back(CUTE(test_mpmc_queue_is_full_after_capacity_pushs));
+	s.push_back(CUTE(test_mpmc_pop_in_sequence_of_push));
+	s.push_back(CUTE(test_mpmc_capacity_one_wraps_around));
+	s.push_back(CUTE(test_mpmc_empty_queue_returns_false_on_try_pop));
+	s.push_back(CUTE(test_mpmc_empty_queue_returns_false_on_try_pop_for));
+	s.push_back(CUTE(test_mpmc_full_queue_returns_false_on_try_push_for));
+	s.push_back(CUTE(test_mpmc_push_moves_element));
+	s.push_back(CUTE(test_mpmc_remaining_elements_are_destroyed));
+	s.push_back(CUTE(test_mpmc_power_of_two_queue_wraps_around));
+	s.push_back(CUTE(test_mpmc_throwing_copy_does_not_claim_a_slot));
+	s.push_back(CUTE(test_mpmc_aligns_over_aligned_elements));
+	return s;
+}
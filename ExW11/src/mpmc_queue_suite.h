@@ -0,0 +1,8 @@
+#ifndef MPMC_QUEUE_SUITE_H_
+#define MPMC_QUEUE_SUITE_H_
+
+#include "cute_suite.h"
+
+extern cute::suite make_suite_mpmc_queue_suite();
+
+#endif
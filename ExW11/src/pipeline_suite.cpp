@@ -0,0 +1,174 @@
+#include "pipeline_suite.h"
+
+#include "cute.h"
+#include "Pipeline.h"
+#include <algorithm>
+#include <atomic>
+#include <future>
+#include <mutex>
+#include <optional>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std::chrono_literals;
+
+// counts from 1 to last, an endless source if last is 0
+struct Counter {
+	std::optional<unsigned> operator()() {
+		auto const next = ++*produced;
+		if (last && next > last) return std::nullopt;
+		return next;
+	}
+
+	unsigned last;
+	std::shared_ptr<std::atomic<unsigned>> produced{std::make_shared<std::atomic<unsigned>>(0)};
+};
+
+void test_pipeline_passes_every_element_through_all_stages_in_order() {
+	Pipeline<> pipeline{};
+	std::vector<std::string> written{};
+	pipeline.source("ingest", Counter{5})
+		.stage("parse", [](unsigned i){ return i * 10; })
+		.stage("enrich", [](unsigned i){ return std::to_string(i) + "!"; })
+		.sink("write", [&](std::string line){ written.push_back(line); });
+	pipeline.run();
+	std::vector<std::string> const expected{"10!", "20!", "30!", "40!", "50!"};
+	ASSERT_EQUAL(expected, written);
+}
+
+void test_pipeline_stage_with_several_workers_processes_every_element() {
+	Pipeline<> pipeline{};
+	std::mutex mx{};
+	std::vector<unsigned> written{};
+	pipeline.source("ingest", Counter{100})
+		.stage("square", [](unsigned i){ return i * i; }, 4, 8)
+		.sink("write", [&](unsigned i){ std::lock_guard<std::mutex> lk{mx}; written.push_back(i); }, 2);
+	pipeline.run();
+	std::sort(std::begin(written), std::end(written));
+	ASSERT_EQUAL(100, written.size());
+	for (unsigned i = 0; i < written.size(); ++i) ASSERT_EQUAL((i + 1) * (i + 1), written[i]);
+}
+
+void test_pipeline_without_sink_does_not_start() {
+	Pipeline<> pipeline{};
+	pipeline.source("ingest", Counter{1}).stage("parse", [](unsigned i){ return i; });
+	ASSERT_THROWS(pipeline.start(), std::logic_error);
+}
+
+void test_pipeline_stage_can_only_be_appended_to_the_end() {
+	Pipeline<> pipeline{};
+	auto ingest = pipeline.source("ingest", Counter{1});
+	ingest.stage("parse", [](unsigned i){ return i; });
+	ASSERT_THROWS(ingest.sink("write", [](unsigned){}), std::logic_error);
+}
+
+void test_pipeline_second_source_throws() {
+	Pipeline<> pipeline{};
+	pipeline.source("ingest", Counter{1});
+	ASSERT_THROWS(pipeline.source("again", Counter{1}), std::logic_error);
+}
+
+void test_pipeline_stage_without_workers_throws() {
+	Pipeline<> pipeline{};
+	auto ingest = pipeline.source("ingest", Counter{1});
+	ASSERT_THROWS(ingest.stage("parse", [](unsigned i){ return i; }, 0), std::invalid_argument);
+}
+
+void test_pipeline_full_queue_blocks_the_source() {
+	Pipeline<> pipeline{};
+	Counter source{50};
+	std::promise<void> open{};
+	auto gate = open.get_future().share();
+	pipeline.source("ingest", source, 1, 2)
+		.sink("write", [gate](unsigned){ gate.wait(); });
+	pipeline.start();
+	std::this_thread::sleep_for(50ms);
+	// two in the queue, one held by the sink and one held by the blocked source
+	ASSERT(*source.produced <= 4);
+	open.set_value();
+	pipeline.wait();
+	ASSERT_EQUAL(50, pipeline.stats().back().processed);
+}
+
+void test_pipeline_counts_processed_elements_of_every_stage() {
+	Pipeline<> pipeline{};
+	pipeline.source("ingest", Counter{20}, 1, 4)
+		.stage("parse", [](unsigned i){ return i; }, 2, 8)
+		.sink("write", [](unsigned){});
+	pipeline.run();
+	auto const stats = pipeline.stats();
+	ASSERT_EQUAL(3, stats.size());
+	for (auto const & stage : stats) ASSERT_EQUAL(20, stage.processed);
+	ASSERT_EQUAL("parse", stats[1].name);
+	ASSERT_EQUAL(2, stats[1].workers);
+	ASSERT_EQUAL(4, stats[1].capacity);
+	ASSERT_EQUAL(8, stats[2].capacity);
+	ASSERT_EQUAL(0, stats[0].capacity);
+}
+
+void test_pipeline_samples_input_queue_occupancy() {
+	Pipeline<> pipeline{};
+	pipeline.source("ingest", Counter{30}, 1, 4)
+		.sink("write", [](unsigned){ std::this_thread::sleep_for(1ms); });
+	pipeline.run();
+	auto const write = pipeline.stats().back();
+	ASSERT(write.peak_queued >= 3);
+	ASSERT(write.peak_queued <= 4);
+	ASSERT(write.mean_queued > 1);
+}
+
+void test_pipeline_reports_slowest_stage_as_bottleneck() {
+	Pipeline<> pipeline{};
+	pipeline.source("ingest", Counter{30}, 1, 2)
+		.stage("slow", [](unsigned i){ std::this_thread::sleep_for(2ms); return i; }, 1, 2)
+		.sink("write", [](unsigned){});
+	pipeline.run();
+	ASSERT_EQUAL("slow", pipeline.bottleneck());
+	std::ostringstream report{};
+	pipeline.report(report);
+	ASSERT(report.str().find("bottleneck: slow") != std::string::npos);
+}
+
+void test_pipeline_rethrows_exception_of_stage_from_wait() {
+	Pipeline<> pipeline{};
+	pipeline.source("ingest", Counter{0})
+		.stage("parse", [](unsigned i){
+			if (i == 3) throw std::runtime_error{"bad record"};
+			return i;
+		})
+		.sink("write", [](unsigned){});
+	pipeline.start();
+	ASSERT_THROWS(pipeline.wait(), std::runtime_error);
+}
+
+void test_pipeline_cancel_stops_endless_source() {
+	Pipeline<> pipeline{};
+	std::atomic<unsigned> written{0};
+	pipeline.source("ingest", Counter{0})
+		.sink("write", [&](unsigned){ ++written; });
+	pipeline.start();
+	while (!written) std::this_thread::yield();
+	pipeline.cancel();
+	pipeline.wait();
+	ASSERT(!pipeline.running());
+}
+
+cute::suite make_suite_pipeline_suite() {
+	cute::suite s;
+	s.push_back(CUTE(test_pipeline_passes_every_element_through_all_stages_in_order));
+	s.push_back(CUTE(test_pipeline_stage_with_several_workers_processes_every_element));
+	s.push_back(CUTE(test_pipeline_without_sink_does_not_start));
+	s.push_back(CUTE(test_pipeline_stage_can_only_be_appended_to_the_end));
+	s.push_back(CUTE(test_pipeline_second_source_throws));
+	s.push_back(CUTE(test_pipeline_stage_without_workers_throws));
+	s.push_back(CUTE(test_pipeline_full_queue_blocks_the_source));
+	s.push_back(CUTE(test_pipeline_counts_processed_elements_of_every_stage));
+	s.push_back(CUTE(test_pipeline_samples_input_queue_occupancy));
+	s.push_back(CUTE(test_pipeline_reports_slowest_stage_as_bottleneck));
+	s.push_back(CUTE(test_pipeline_rethrows_exception_of_stage_from_wait));
+	s.push_back(CUTE(test_pipeline_cancel_stops_endless_source));
+	return s;
+}
@@ -0,0 +1,8 @@
+#ifndef PIPELINE_SUITE_H_
+#define PIPELINE_SUITE_H_
+
+#include "cute_suite.h"
+
+extern cute::suite make_suite_pipeline_suite();
+
+#endif
@@ -0,0 +1,137 @@
+#include "selector_suite.h"
+
+#include "cute.h"
+#include "BoundedQueue.h"
+#include "Selector.h"
+#include "times_literal.hpp"
+#include <future>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace times::literal;
+using namespace std::chrono_literals;
+
+void test_selector_without_queues_throws() {
+	ASSERT_THROWS(Selector<BoundedQueue<int>> selector{{}}, std::invalid_argument);
+}
+
+void test_selector_on_empty_queues_is_not_ready() {
+	BoundedQueue<int> first{5}, second{5};
+	Selector<BoundedQueue<int>> selector{{&first, &second}};
+	ASSERT(!selector.ready());
+}
+
+void test_selector_returns_index_of_non_empty_queue() {
+	BoundedQueue<int> first{5}, second{5}, third{5};
+	Selector<BoundedQueue<int>> selector{{&first, &second, &third}};
+	third.push(1);
+	ASSERT_EQUAL(2, selector.wait());
+}
+
+void test_selector_wait_for_times_out_on_empty_queues() {
+	BoundedQueue<int> first{5}, second{5};
+	Selector<BoundedQueue<int>> selector{{&first, &second}};
+	auto const start = std::chrono::steady_clock::now();
+	ASSERT(!selector.wait_for(20ms));
+	ASSERT(std::chrono::steady_clock::now() - start >= 20ms);
+}
+
+void test_selector_reports_closed_queue_as_ready() {
+	BoundedQueue<int> first{5}, second{5};
+	Selector<BoundedQueue<int>> selector{{&first, &second}};
+	second.close();
+	ASSERT_EQUAL(1, selector.wait());
+}
+
+void test_round_robin_selector_alternates_between_ready_queues() {
+	BoundedQueue<int> first{5}, second{5};
+	Selector<BoundedQueue<int>> selector{{&first, &second}, SelectOrder::round_robin};
+	first.push(1);
+	second.push(2);
+	std::vector<size_t> selected{}, expected{0, 1, 0, 1};
+	4_times([&]{ selected.push_back(selector.wait()); });
+	ASSERT_EQUAL(expected, selected);
+}
+
+void test_in_order_selector_prefers_lowest_index() {
+	BoundedQueue<int> first{5}, second{5};
+	Selector<BoundedQueue<int>> selector{{&first, &second}, SelectOrder::in_order};
+	first.push(1);
+	second.push(2);
+	std::vector<size_t> selected{}, expected{0, 0, 0};
+	3_times([&]{ selected.push_back(selector.wait()); });
+	ASSERT_EQUAL(expected, selected);
+}
+
+void test_selector_is_woken_by_push_to_any_queue() {
+	BoundedQueue<int> first{5}, second{5}, third{5};
+	Selector<BoundedQueue<int>> selector{{&first, &second, &third}};
+	auto producer = std::async(std::launch::async, [&]{
+		std::this_thread::sleep_for(50ms);
+		second.push(23);
+	});
+	auto const index = selector.wait_for(5s);
+	ASSERT(index.has_value());
+	ASSERT_EQUAL(1, *index);
+	ASSERT_EQUAL(23, second.pop());
+}
+
+void test_wait_any_returns_index_of_ready_queue() {
+	BoundedQueue<int> first{5}, second{5};
+	auto producer = std::async(std::launch::async, [&]{
+		std::this_thread::sleep_for(50ms);
+		first.push(1);
+	});
+	ASSERT_EQUAL(0, wait_any(first, second));
+}
+
+void test_selector_unsubscribes_on_destruction() {
+	BoundedQueue<int> queue{5};
+	{
+		Selector<BoundedQueue<int>> selector{{&queue}};
+	}
+	queue.push(1);
+	ASSERT_EQUAL(1, queue.pop());
+}
+
+void test_router_services_all_queues() {
+	const unsigned nOfQueues = 8, perQueue = 1000;
+	std::vector<BoundedQueue<unsigned>> queues{};
+	queues.reserve(nOfQueues);
+	std::vector<BoundedQueue<unsigned> *> pointers{};
+	for (unsigned i = 0; i < nOfQueues; ++i) {
+		queues.emplace_back(4);
+		pointers.push_back(&queues.back());
+	}
+	Selector<BoundedQueue<unsigned>> selector{pointers};
+
+	std::vector<std::future<void>> producers{};
+	for (auto & queue : queues) {
+		producers.push_back(std::async(std::launch::async, [&queue]{
+			for (unsigned i = 0; i < perQueue; ++i) queue.push(i);
+		}));
+	}
+	unsigned routed{0};
+	while (routed < nOfQueues * perQueue) {
+		unsigned value{};
+		if (queues[selector.wait()].try_pop(value)) ++routed;
+	}
+	ASSERT_EQUAL(nOfQueues * perQueue, routed);
+}
+
+cute::suite make_suite_selector_suite() {
+	cute::suite s;
+	s.push_back(CUTE(test_selector_without_queues_throws));
+	s.push_back(CUTE(test_selector_on_empty_queues_is_not_ready));
+	s.push_back(CUTE(test_selector_returns_index_of_non_empty_queue));
+	s.push_back(CUTE(test_selector_wait_for_times_out_on_empty_queues));
+	s.push_back(CUTE(test_selector_reports_closed_queue_as_ready));
+	s.push_back(CUTE(test_round_robin_selector_alternates_between_ready_queues));
+	s.push_back(CUTE(test_in_order_selector_prefers_lowest_index));
+	s.push_back(CUTE(test_selector_is_woken_by_push_to_any_queue));
+	s.push_back(CUTE(test_wait_any_returns_index_of_ready_queue));
+	s.push_back(CUTE(test_selector_unsubscribes_on_destruction));
+	s.push_back(CUTE(test_router_services_all_queues));
+	return s;
+}
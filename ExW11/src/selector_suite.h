@@ -0,0 +1,8 @@
+#ifndef SELECTOR_SUITE_H_
+#define SELECTOR_SUITE_H_
+
+#include "cute_suite.h"
+
+extern cute::suite make_suite_selector_suite();
+
+#endif
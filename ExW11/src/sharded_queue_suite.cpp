@@ -0,0 +1,168 @@
+#include "sharded_queue_suite.h"
+
+#include "cute.h"
+#include "ShardedQueue.h"
+#include "times_literal.hpp"
+#include <algorithm>
+#include <future>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace times::literal;
+using namespace std::chrono_literals;
+
+void test_sharded_constructor_for_capacity_zero_throws() {
+	ASSERT_THROWS(ShardedQueue<int> queue(0, 4), std::invalid_argument);
+}
+
+void test_sharded_constructor_for_zero_lanes_throws() {
+	ASSERT_THROWS(ShardedQueue<int> queue(4, 0), std::invalid_argument);
+}
+
+void test_sharded_capacity_is_distributed_over_lanes() {
+	ShardedQueue<int> const queue(10, 4);
+	ASSERT_EQUAL(4, queue.lanes());
+	ASSERT_EQUAL(10, queue.capacity());
+}
+
+void test_sharded_queue_has_no_more_lanes_than_capacity() {
+	ShardedQueue<int> const queue(3, 8);
+	ASSERT_EQUAL(3, queue.lanes());
+}
+
+void test_sharded_new_queue_is_empty() {
+	ShardedQueue<int> const queue(10, 4);
+	ASSERT(queue.empty());
+	ASSERT_EQUAL(0, queue.size());
+}
+
+void test_sharded_push_spills_over_to_other_lanes_until_full() {
+	ShardedQueue<int> queue(10, 4);
+	10_times([&]{ queue.push(1); });
+	ASSERT(queue.full());
+	ASSERT(!queue.try_push(1));
+}
+
+void test_sharded_pop_steals_from_other_lanes() {
+	ShardedQueue<int> queue(10, 4);
+	std::vector<int> popped{}, expected{0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+	for (int i = 0; i < 10; ++i) queue.push(i);
+	10_times([&]{ popped.push_back(queue.pop()); });
+	std::sort(std::begin(popped), std::end(popped));
+	ASSERT_EQUAL(expected, popped);
+	ASSERT(queue.empty());
+}
+
+void test_sharded_single_lane_keeps_fifo_order() {
+	ShardedQueue<int> queue(3, 1);
+	queue.push(1);
+	queue.push(2);
+	ASSERT_EQUAL(1, queue.pop());
+	ASSERT_EQUAL(2, queue.pop());
+}
+
+void test_sharded_empty_queue_returns_false_on_try_pop() {
+	ShardedQueue<int> queue(10, 4);
+	int val{};
+	ASSERT(!queue.try_pop(val));
+	ASSERT(!queue.try_pop());
+}
+
+void test_sharded_empty_queue_returns_false_on_try_pop_for() {
+	ShardedQueue<int> queue(10, 4);
+	int val{};
+	ASSERT(!queue.try_pop_for(val, 1ms));
+}
+
+void test_sharded_full_queue_returns_false_on_try_push_for() {
+	ShardedQueue<int> queue(2, 2);
+	2_times([&]{ queue.push(1); });
+	ASSERT(!queue.try_push_for(1, 1ms));
+}
+
+void test_sharded_pop_drains_closed_queue_then_throws() {
+	ShardedQueue<int> queue(10, 4);
+	queue.push(1);
+	queue.close();
+	ASSERT_THROWS(queue.push(2), closed_queue);
+	ASSERT_EQUAL(1, queue.pop());
+	ASSERT_THROWS(queue.pop(), closed_queue);
+}
+
+void test_sharded_close_wakes_blocked_consumers() {
+	ShardedQueue<int> queue(10, 4);
+	std::vector<std::future<int>> consumers{};
+	4_times([&]{
+		consumers.push_back(std::async(std::launch::async, [&]{ return queue.pop(); }));
+	});
+	std::this_thread::sleep_for(50ms);
+
+	queue.close();
+	for (auto & consumer : consumers) {
+		ASSERT_NOT_EQUAL_TO(std::future_status::timeout, consumer.wait_for(1s));
+		ASSERT_THROWS(consumer.get(), closed_queue);
+	}
+}
+
+void test_sharded_blocked_producer_is_woken_by_pop_on_any_lane() {
+	ShardedQueue<int> queue(2, 2);
+	2_times([&]{ queue.push(1); });
+
+	auto producer = std::async(std::launch::async, [&]{ queue.push(2); });
+	std::this_thread::sleep_for(50ms);
+
+	queue.pop();
+	ASSERT_NOT_EQUAL_TO(std::future_status::timeout, producer.wait_for(1s));
+	ASSERT(queue.full());
+}
+
+void test_sharded_close_wakes_blocked_producers() {
+	ShardedQueue<int> queue(2, 2);
+	2_times([&]{ queue.push(1); });
+	std::vector<std::future<void>> producers{};
+	2_times([&]{
+		producers.push_back(std::async(std::launch::async, [&]{ queue.push(2); }));
+	});
+	std::this_thread::sleep_for(50ms);
+
+	queue.close();
+	for (auto & producer : producers) {
+		ASSERT_NOT_EQUAL_TO(std::future_status::timeout, producer.wait_for(1s));
+		ASSERT_THROWS(producer.get(), closed_queue);
+	}
+}
+
+void test_sharded_timed_pop_is_woken_by_push() {
+	ShardedQueue<int> queue(4, 4);
+	auto consumer = std::async(std::launch::async, [&]{
+		int value{};
+		return queue.try_pop_for(value, 10s) ? value : 0;
+	});
+	std::this_thread::sleep_for(50ms);
+
+	queue.push(42);
+	ASSERT_NOT_EQUAL_TO(std::future_status::timeout, consumer.wait_for(1s));
+	ASSERT_EQUAL(42, consumer.get());
+}
+
+cute::suite make_suite_sharded_queue_suite() {
+	cute::suite s;
+	s.push_back(CUTE(test_sharded_constructor_for_capacity_zero_throws));
+	s.push_back(CUTE(test_sharded_constructor_for_zero_lanes_throws));
+	s.push_back(CUTE(test_sharded_capacity_is_distributed_over_lanes));
+	s.push_back(CUTE(test_sharded_queue_has_no_more_lanes_than_capacity));
+	s.push_back(CUTE(test_sharded_new_queue_is_empty));
+	s.push_back(CUTE(test_sharded_push_spills_over_to_other_lanes_until_full));
+	s.push_back(CUTE(test_sharded_pop_steals_from_other_lanes));
+	s.push_back(CUTE(test_sharded_single_lane_keeps_fifo_order));
+	s.push_back(CUTE(test_sharded_empty_queue_returns_false_on_try_pop));
+	s.push_back(CUTE(test_sharded_empty_queue_returns_false_on_try_pop_for));
+	s.push_back(CUTE(test_sharded_full_queue_returns_false_on_try_push_for));
+	s.push_back(CUTE(test_sharded_pop_drains_closed_queue_then_throws));
+	s.push_back(CUTE(test_sharded_close_wakes_blocked_consumers));
+	s.push_back(CUTE(test_sharded_blocked_producer_is_woken_by_pop_on_any_lane));
+	s.push_back(CUTE(test_sharded_close_wakes_blocked_producers));
+	s.push_back(CUTE(test_sharded_timed_pop_is_woken_by_push));
+	return s;
+}
@@ -0,0 +1,8 @@
+#ifndef SHARDED_QUEUE_SUITE_H_
+#define SHARDED_QUEUE_SUITE_H_
+
+#include "cute_suite.h"
+
+extern cute::suite make_suite_sharded_queue_suite();
+
+#endif
@@ -0,0 +1,191 @@
+#include "spsc_queue_suite.h"
+
+#include "cute.h"
+#include "SPSCQueue.h"
+#include "MemoryOperationCounter.h"
+#include "times_literal.hpp"
+#include <cstdint>
+#include <memory>
+#include <future>
+#include <numeric>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <time.h>
+
+using namespace times::literal;
+using namespace std::chrono_literals;
+
+void test_spsc_constructor_for_capacity_zero_throws() {
+	ASSERT_THROWS(SPSCQueue<int> queue{0}, std::invalid_argument);
+}
+
+void test_spsc_new_queue_is_empty() {
+	SPSCQueue<int> const queue{5};
+	ASSERT(queue.empty());
+	ASSERT_EQUAL(0, queue.size());
+}
+
+void test_spsc_queue_is_full_after_capacity_pushs() {
+	SPSCQueue<int> queue{3};
+	3_times([&]{ queue.push(1); });
+	ASSERT(queue.full());
+}
+
+void test_spsc_pop_in_sequence_of_push() {
+	SPSCQueue<int> queue{5};
+	queue.push(1);
+	queue.push(2);
+	queue.push(3);
+	ASSERT_EQUAL(1, queue.pop());
+	ASSERT_EQUAL(2, queue.pop());
+	ASSERT_EQUAL(3, queue.pop());
+}
+
+void test_spsc_wrap_around_keeps_order() {
+	SPSCQueue<int> queue{3};
+	for (int i = 0; i < 10; ++i) {
+		queue.push(i);
+		ASSERT_EQUAL(i, queue.pop());
+	}
+	ASSERT(queue.empty());
+}
+
+void test_spsc_full_queue_returns_false_on_try_push() {
+	SPSCQueue<int> queue{1};
+	queue.push(1);
+	ASSERT(!queue.try_push(2));
+}
+
+void test_spsc_empty_queue_returns_false_on_try_pop() {
+	SPSCQueue<int> queue{1};
+	int val{};
+	ASSERT(!queue.try_pop(val));
+}
+
+void test_spsc_empty_queue_returns_false_on_try_pop_for() {
+	SPSCQueue<int> queue{1};
+	int val{};
+	ASSERT(!queue.try_pop_for(val, 1ms));
+}
+
+void test_spsc_full_queue_returns_false_on_try_push_for() {
+	SPSCQueue<int> queue{1};
+	queue.push(1);
+	ASSERT(!queue.try_push_for(2, 1ms));
+}
+
+void test_spsc_push_moves_element() {
+	SPSCQueue<MemoryOperationCounter> queue{1};
+	MemoryOperationCounter counter{}, expected{2, 0, true};
+	queue.push(std::move(counter));
+	ASSERT_EQUAL(expected, queue.pop());
+}
+
+struct alignas(64) SPSCOverAligned {
+	SPSCOverAligned(int value) : value{value} { misaligned |= reinterpret_cast<std::uintptr_t>(this) % alignof(SPSCOverAligned); }
+	SPSCOverAligned(SPSCOverAligned && other) noexcept : SPSCOverAligned{other.value} {}
+	int value;
+	static bool misaligned;
+};
+bool SPSCOverAligned::misaligned{false};
+
+void test_spsc_aligns_over_aligned_elements() {
+	SPSCOverAligned::misaligned = false;
+	std::vector<std::unique_ptr<SPSCQueue<SPSCOverAligned>>> queues{};
+	for (std::size_t capacity = 1; capacity <= 8; ++capacity) {
+		auto & queue = *queues.emplace_back(std::make_unique<SPSCQueue<SPSCOverAligned>>(capacity));
+		queue.push(SPSCOverAligned{1});
+		ASSERT_EQUAL(1, queue.pop().value);
+	}
+	ASSERT(!SPSCOverAligned::misaligned);
+}
+
+struct SPSCDestructionCounter {
+	static unsigned destructions;
+	~SPSCDestructionCounter() { ++destructions; }
+};
+unsigned SPSCDestructionCounter::destructions{0};
+
+void test_spsc_remaining_elements_are_destroyed() {
+	{
+		SPSCQueue<SPSCDestructionCounter> queue{4};
+		3_times([&]{ queue.push(SPSCDestructionCounter{}); });
+		SPSCDestructionCounter::destructions = 0;
+	}
+	ASSERT_EQUAL(3, SPSCDestructionCounter::destructions);
+}
+
+void test_spsc_one_producer_and_one_consumer() {
+	const unsigned nOfElements = 100000;
+	std::vector<unsigned> expected(nOfElements, 0);
+	std::iota(std::begin(expected), std::end(expected), 0);
+	SPSCQueue<unsigned> queue{16};
+	auto producer = std::async(std::launch::async, [&]{
+		for (unsigned i = 0; i < nOfElements; ++i) queue.push(i);
+	});
+	auto consumer = std::async(std::launch::async, [&]{
+		std::vector<unsigned> popped{};
+		for (unsigned i = 0; i < nOfElements; ++i) popped.push_back(queue.pop());
+		return popped;
+	});
+	ASSERT_NOT_EQUAL_TO(std::future_status::timeout, producer.wait_for(std::chrono::seconds{1}));
+	ASSERT_NOT_EQUAL_TO(std::future_status::timeout, consumer.wait_for(std::chrono::seconds{1}));
+	ASSERT_EQUAL(expected, consumer.get());
+}
+
+std::chrono::nanoseconds threadCpuTime() {
+	timespec ts{};
+	::clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+	return std::chrono::seconds{ts.tv_sec} + std::chrono::nanoseconds{ts.tv_nsec};
+}
+
+void test_spsc_blocked_consumer_parks_until_push() {
+	SPSCQueue<int> queue{4};
+	auto consumer = std::async(std::launch::async, [&]{
+		auto const start = threadCpuTime();
+		auto const value = queue.pop();
+		return std::make_pair(value, threadCpuTime() - start);
+	});
+	std::this_thread::sleep_for(100ms);
+	queue.push(42);
+	auto const [value, cpu] = consumer.get();
+	ASSERT_EQUAL(42, value);
+	ASSERT(cpu < 20ms);
+}
+
+void test_spsc_blocked_producer_parks_until_pop() {
+	SPSCQueue<int> queue{1};
+	queue.push(1);
+	auto producer = std::async(std::launch::async, [&]{
+		auto const start = threadCpuTime();
+		queue.push(2);
+		return threadCpuTime() - start;
+	});
+	std::this_thread::sleep_for(100ms);
+	ASSERT_EQUAL(1, queue.pop());
+	ASSERT(producer.get() < 20ms);
+	ASSERT_EQUAL(2, queue.pop());
+}
+
+cute::suite make_suite_spsc_queue_suite() {
+	cute::suite s;
+	s.push_back(CUTE(test_spsc_constructor_for_capacity_zero_throws));
+	s.push_back(CUTE(test_spsc_new_queue_is_empty));
+	s.push_back(CUTE(test_spsc_queue_is_full_after_capacity_pushs));
+	s.push_back(CUTE(test_spsc_pop_in_sequence_of_push));
+	s.push_back(CUTE(test_spsc_wrap_around_keeps_order));
+	s.push_back(CUTE(test_spsc_full_queue_returns_false_on_try_push));
+	s.push_back(CUTE(test_spsc_empty_queue_returns_false_on_try_pop));
+	s.push_back(CUTE(test_spsc_empty_queue_returns_false_on_try_pop_for));
+	s.push_back(CUTE(test_spsc_full_queue_returns_false_on_try_push_for));
+	s.push_back(CUTE(test_spsc_push_moves_element));
+	s.push_back(CUTE(test_spsc_aligns_over_aligned_elements));
+	s.push_back(CUTE(test_spsc_remaining_elements_are_destroyed));
+	s.push_back(CUTE(test_spsc_one_producer_and_one_consumer));
+	s.push_back(CUTE(test_spsc_blocked_consumer_parks_until_push));
+	s.push_back(CUTE(test_spsc_blocked_producer_parks_until_pop));
+	return s;
+}
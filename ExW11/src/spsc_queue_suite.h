@@ -0,0 +1,8 @@
+#ifndef SPSC_QUEUE_SUITE_H_
+#define SPSC_QUEUE_SUITE_H_
+
+#include "cute_suite.h"
+
+extern cute::suite make_suite_spsc_queue_suite();
+
+#endif
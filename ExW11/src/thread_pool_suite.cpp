@@ -0,0 +1,153 @@
+#include "thread_pool_suite.h"
+
+#include "cute.h"
+#include "ThreadPool.h"
+#include "Task.h"
+#include "times_literal.hpp"
+#include <array>
+#include <atomic>
+#include <future>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace times::literal;
+using namespace std::chrono_literals;
+
+template<std::size_t N>
+struct CountingCallable {
+	static void* operator new(std::size_t sz) {
+		++allocations;
+		return ::operator new(sz);
+	}
+	static void operator delete(void* ptr) {
+		::operator delete(ptr);
+	}
+	void operator()() { ++calls; }
+
+	std::array<char, N> payload{};
+	static unsigned allocations;
+	static unsigned calls;
+};
+template<std::size_t N>
+unsigned CountingCallable<N>::allocations{0};
+template<std::size_t N>
+unsigned CountingCallable<N>::calls{0};
+
+void test_default_task_is_empty() {
+	Task const task{};
+	ASSERT(!task);
+}
+
+void test_task_calls_callable() {
+	int calls{0};
+	Task task{[&]{ ++calls; }};
+	task();
+	ASSERT_EQUAL(1, calls);
+}
+
+void test_small_task_is_stored_inline() {
+	using Small = CountingCallable<Task::buffer_size>;
+	Small::allocations = 0;
+	Small::calls = 0;
+	Task task{Small{}};
+	Task moved{std::move(task)};
+	moved();
+	ASSERT_EQUAL(0, Small::allocations);
+	ASSERT_EQUAL(1, Small::calls);
+}
+
+void test_large_task_is_stored_on_heap() {
+	using Large = CountingCallable<Task::buffer_size + 1>;
+	Large::allocations = 0;
+	Large::calls = 0;
+	Task task{Large{}};
+	Task moved{std::move(task)};
+	moved();
+	ASSERT_EQUAL(1, Large::allocations);
+	ASSERT_EQUAL(1, Large::calls);
+}
+
+void test_task_destroys_callable() {
+	auto counter = std::make_shared<int>(0);
+	{
+		Task task{[counter]{}};
+		ASSERT_EQUAL(2, counter.use_count());
+	}
+	ASSERT_EQUAL(1, counter.use_count());
+}
+
+void test_task_takes_move_only_callable() {
+	auto value = std::make_unique<int>(23);
+	int result{0};
+	Task task{[value = std::move(value), &result]{ result = *value; }};
+	Task other{};
+	other = std::move(task);
+	other();
+	ASSERT_EQUAL(23, result);
+	ASSERT(!task);
+}
+
+void test_pool_constructor_for_zero_threads_throws() {
+	ASSERT_THROWS(ThreadPool<> pool(0), std::invalid_argument);
+}
+
+void test_submit_returns_result() {
+	ThreadPool<> pool{2};
+	auto result = pool.submit([]{ return std::string{"done"}; });
+	ASSERT_EQUAL("done", result.get());
+}
+
+void test_submit_passes_exception_to_future() {
+	ThreadPool<> pool{2};
+	auto result = pool.submit([]() -> int { throw std::logic_error{"failed"}; });
+	ASSERT_THROWS(result.get(), std::logic_error);
+}
+
+void test_all_posted_tasks_run_before_shutdown_returns() {
+	std::atomic<unsigned> calls{0};
+	ThreadPool<> pool{4, 8};
+	1000_times([&]{ pool.post([&]{ ++calls; }); });
+	pool.shutdown();
+	ASSERT_EQUAL(1000, calls.load());
+}
+
+void test_submit_after_shutdown_throws() {
+	ThreadPool<> pool{1};
+	pool.shutdown();
+	ASSERT_THROWS(pool.submit([]{ return 1; }), closed_queue);
+}
+
+void test_post_blocks_while_queue_is_full() {
+	ThreadPool<> pool{1, 1};
+	std::promise<void> release{};
+	auto released = release.get_future().share();
+	pool.post([released]{ released.wait(); });
+	while (pool.pending()) std::this_thread::yield();
+	pool.post([]{});
+
+	auto blocked = std::async(std::launch::async, [&]{ pool.post([]{}); });
+	ASSERT_EQUAL(std::future_status::timeout, blocked.wait_for(50ms));
+	ASSERT(!pool.try_post([]{}));
+
+	release.set_value();
+	ASSERT_NOT_EQUAL_TO(std::future_status::timeout, blocked.wait_for(1s));
+}
+
+cute::suite make_suite_thread_pool_suite() {
+	cute::suite s;
+	s.push_back(CUTE(test_default_task_is_empty));
+	s.push_back(CUTE(test_task_calls_callable));
+	s.push_back(CUTE(test_small_task_is_stored_inline));
+	s.push_back(CUTE(test_large_task_is_stored_on_heap));
+	s.push_back(CUTE(test_task_destroys_callable));
+	s.push_back(CUTE(test_task_takes_move_only_callable));
+	s.push_back(CUTE(test_pool_constructor_for_zero_threads_throws));
+	s.push_back(CUTE(test_submit_returns_result));
+	s.push_back(CUTE(test_submit_passes_exception_to_future));
+	s.push_back(CUTE(test_all_posted_tasks_run_before_shutdown_returns));
+	s.push_back(CUTE(test_submit_after_shutdown_throws));
+	s.push_back(CUTE(test_post_blocks_while_queue_is_full));
+	return s;
+}
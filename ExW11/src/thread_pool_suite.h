@@ -0,0 +1,8 @@
+#ifndef THREAD_POOL_SUITE_H_
+#define THREAD_POOL_SUITE_H_
+
+#include "cute_suite.h"
+
+extern cute::suite make_suite_thread_pool_suite();
+
+#endif
@@ -0,0 +1,216 @@
+#include "two_lock_queue_suite.h"
+
+#include "cute.h"
+#include "TwoLockQueue.h"
+#include "times_literal.hpp"
+#include <condition_variable>
+#include <cstdint>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace times::literal;
+using namespace std::chrono_literals;
+
+struct lock_counting_mutex {
+	void lock() { mx.lock(); ++locks; }
+	void unlock() { mx.unlock(); }
+	bool try_lock() { return mx.try_lock() && ++locks; }
+
+	std::mutex mx{};
+	static unsigned locks;
+};
+unsigned lock_counting_mutex::locks{0};
+
+using LockCountingTwoLockQueue = TwoLockQueue<int, lock_counting_mutex, std::condition_variable_any>;
+
+struct notify_counting_condition_variable : std::condition_variable_any {
+	void notify_one() noexcept { ++notifies; std::condition_variable_any::notify_one(); }
+
+	static unsigned notifies;
+};
+unsigned notify_counting_condition_variable::notifies{0};
+
+using NotifyCountingTwoLockQueue = TwoLockQueue<int, std::mutex, notify_counting_condition_variable>;
+
+void test_two_lock_queue_constructor_for_capacity_zero_throws() {
+	ASSERT_THROWS(TwoLockQueue<int> queue{0}, std::invalid_argument);
+}
+
+void test_new_two_lock_queue_is_empty() {
+	TwoLockQueue<int> const queue{5};
+	ASSERT(queue.empty());
+	ASSERT_EQUAL(0, queue.size());
+	ASSERT_EQUAL(5, queue.capacity());
+}
+
+void test_two_lock_queue_keeps_fifo_order_across_wrap_around() {
+	TwoLockQueue<int> queue{3};
+	std::vector<int> popped{}, expected{1, 2, 3, 4, 5, 6, 7};
+	for (int i = 1; i <= 7; ++i) {
+		queue.push(i);
+		if (queue.full()) popped.push_back(queue.pop());
+	}
+	while (!queue.empty()) popped.push_back(queue.pop());
+	ASSERT_EQUAL(expected, popped);
+}
+
+void test_full_two_lock_queue_rejects_try_push() {
+	TwoLockQueue<int> queue{2};
+	ASSERT(queue.try_push(1));
+	ASSERT(queue.try_push(2));
+	ASSERT(!queue.try_push(3));
+	ASSERT(!queue.try_push_for(4, 10ms));
+	ASSERT_EQUAL(2, queue.size());
+}
+
+void test_empty_two_lock_queue_try_pop_fails() {
+	TwoLockQueue<int> queue{2};
+	int ele{23};
+	ASSERT(!queue.try_pop(ele));
+	ASSERT(!queue.try_pop());
+	ASSERT(!queue.try_pop_for(ele, 10ms));
+	ASSERT(!queue.try_pop_for(10ms));
+	ASSERT_EQUAL(23, ele);
+}
+
+void test_two_lock_queue_remaining_elements_are_destroyed() {
+	auto counter = std::make_shared<int>(0);
+	{
+		TwoLockQueue<std::shared_ptr<int>> queue{5};
+		4_times([&]{ queue.push(counter); });
+		queue.pop();
+		ASSERT_EQUAL(4, counter.use_count());
+	}
+	ASSERT_EQUAL(1, counter.use_count());
+}
+
+void test_push_into_non_empty_two_lock_queue_takes_only_the_tail_lock() {
+	LockCountingTwoLockQueue queue{5};
+	queue.push(1);
+	lock_counting_mutex::locks = 0;
+	queue.push(2);
+	ASSERT_EQUAL(1, lock_counting_mutex::locks);
+}
+
+void test_pop_from_non_full_two_lock_queue_takes_only_the_head_lock() {
+	LockCountingTwoLockQueue queue{5};
+	queue.push(1);
+	queue.push(2);
+	lock_counting_mutex::locks = 0;
+	queue.pop();
+	ASSERT_EQUAL(1, lock_counting_mutex::locks);
+}
+
+void test_timed_push_and_pop_do_not_wake_their_own_side() {
+	NotifyCountingTwoLockQueue queue{5};
+	queue.push(1);
+	notify_counting_condition_variable::notifies = 0;
+	ASSERT(queue.try_push_for(2, 10ms));
+	ASSERT(queue.try_pop_for(10ms));
+	ASSERT_EQUAL(0, notify_counting_condition_variable::notifies);
+}
+
+struct alignas(64) TwoLockOverAligned {
+	TwoLockOverAligned(int value) : value{value} { misaligned |= reinterpret_cast<std::uintptr_t>(this) % alignof(TwoLockOverAligned); }
+	TwoLockOverAligned(TwoLockOverAligned && other) noexcept : TwoLockOverAligned{other.value} {}
+	TwoLockOverAligned & operator=(TwoLockOverAligned &&) = default;
+	int value;
+	static bool misaligned;
+};
+bool TwoLockOverAligned::misaligned{false};
+
+void test_two_lock_queue_aligns_over_aligned_elements() {
+	TwoLockQueue<TwoLockOverAligned> queue{3};
+	TwoLockOverAligned::misaligned = false;
+	3_times([&]{ queue.push(TwoLockOverAligned{1}); });
+	ASSERT_EQUAL(1, queue.pop().value);
+	ASSERT(!TwoLockOverAligned::misaligned);
+}
+
+void test_two_lock_queue_blocked_consumer_unblocks() {
+	TwoLockQueue<int> queue{1};
+	auto f = std::async(std::launch::async, [&]{
+		std::this_thread::sleep_for(50ms);
+		queue.push(1);
+	});
+	ASSERT_EQUAL(1, queue.pop());
+}
+
+void test_two_lock_queue_blocked_producer_unblocks() {
+	TwoLockQueue<int> queue{1};
+	queue.push(1);
+	auto f = std::async(std::launch::async, [&]{
+		std::this_thread::sleep_for(50ms);
+		queue.pop();
+	});
+	queue.push(2);
+	ASSERT_EQUAL(2, queue.pop());
+}
+
+void test_closed_two_lock_queue_drains_then_throws() {
+	TwoLockQueue<int> queue{5};
+	queue.push(1);
+	queue.push(2);
+	queue.close();
+	ASSERT(queue.is_closed());
+	ASSERT_THROWS(queue.push(3), closed_queue);
+	ASSERT(!queue.try_push(3));
+	ASSERT_EQUAL(1, queue.pop());
+	ASSERT_EQUAL(2, queue.pop());
+	ASSERT_THROWS(queue.pop(), closed_queue);
+}
+
+void test_close_wakes_blocked_two_lock_queue_consumer() {
+	TwoLockQueue<int> queue{1};
+	auto consumer = std::async(std::launch::async, [&]{ return queue.try_pop_for(10s); });
+	std::this_thread::sleep_for(50ms);
+	queue.close();
+	ASSERT(!consumer.get());
+}
+
+void test_two_lock_queue_producers_and_consumers_see_every_element_once() {
+	unsigned const perProducer{20000};
+	TwoLockQueue<unsigned> queue{16};
+	std::vector<std::future<unsigned long long>> consumers{};
+	std::vector<std::future<void>> producers{};
+	for (unsigned c = 0; c < 4; ++c) {
+		consumers.push_back(std::async(std::launch::async, [&]{
+			unsigned long long sum{0};
+			for (unsigned i = 0; i < perProducer; ++i) sum += queue.pop();
+			return sum;
+		}));
+	}
+	for (unsigned p = 0; p < 4; ++p) {
+		producers.push_back(std::async(std::launch::async, [&]{
+			for (unsigned i = 1; i <= perProducer; ++i) queue.push(i);
+		}));
+	}
+	unsigned long long sum{0};
+	for (auto & consumer : consumers) sum += consumer.get();
+	ASSERT_EQUAL(4ull * perProducer * (perProducer + 1) / 2, sum);
+	ASSERT(queue.empty());
+}
+
+cute::suite make_suite_two_lock_queue_suite() {
+	cute::suite s;
+	s.push_back(CUTE(test_two_lock_queue_constructor_for_capacity_zero_throws));
+	s.push_back(CUTE(test_new_two_lock_queue_is_empty));
+	s.push_back(CUTE(test_two_lock_queue_keeps_fifo_order_across_wrap_around));
+	s.push_back(CUTE(test_full_two_lock_queue_rejects_try_push));
+	s.push_back(CUTE(test_empty_two_lock_queue_try_pop_fails));
+	s.push_back(CUTE(test_two_lock_queue_remaining_elements_are_destroyed));
+	s.push_back(CUTE(test_timed_push_and_pop_do_not_wake_their_own_side));
+	s.push_back(CUTE(test_two_lock_queue_aligns_over_aligned_elements));
+	s.push_back(CUTE(test_push_into_non_empty_two_lock_queue_takes_only_the_tail_lock));
+	s.push_back(CUTE(test_pop_from_non_full_two_lock_queue_takes_only_the_head_lock));
+	s.push_back(CUTE(test_two_lock_queue_blocked_consumer_unblocks));
+	s.push_back(CUTE(test_two_lock_queue_blocked_producer_unblocks));
+	s.push_back(CUTE(test_closed_two_lock_queue_drains_then_throws));
+	s.push_back(CUTE(test_close_wakes_blocked_two_lock_queue_consumer));
+	s.push_back(CUTE(test_two_lock_queue_producers_and_consumers_see_every_element_once));
+	return s;
+}
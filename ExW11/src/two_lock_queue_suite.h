@@ -0,0 +1,8 @@
+#ifndef TWO_LOCK_QUEUE_SUITE_H_
+#define TWO_LOCK_QUEUE_SUITE_H_
+
+#include "cute_suite.h"
+
+extern cute::suite make_suite_two_lock_queue_suite();
+
+#endif
@@ -0,0 +1,120 @@
+#include "work_stealing_deque_suite.h"
+
+#include "cute.h"
+#include "WorkStealingDeque.h"
+#include "times_literal.hpp"
+#include <algorithm>
+#include <atomic>
+#include <future>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+
+using namespace times::literal;
+
+void test_deque_constructor_for_capacity_zero_throws() {
+	ASSERT_THROWS(WorkStealingDeque<int> deque{0}, std::invalid_argument);
+}
+
+void test_deque_capacity_is_rounded_up_to_power_of_two() {
+	WorkStealingDeque<int> const deque{5};
+	ASSERT_EQUAL(8, deque.capacity());
+}
+
+void test_new_deque_is_empty() {
+	WorkStealingDeque<int> deque{4};
+	ASSERT(deque.empty());
+	ASSERT(!deque.try_pop());
+	ASSERT(!deque.try_steal());
+}
+
+void test_deque_owner_pops_in_lifo_order() {
+	WorkStealingDeque<int> deque{4};
+	deque.try_push(1);
+	deque.try_push(2);
+	deque.try_push(3);
+	ASSERT_EQUAL(3, deque.try_pop().value());
+	ASSERT_EQUAL(2, deque.try_pop().value());
+	ASSERT_EQUAL(1, deque.try_pop().value());
+	ASSERT(deque.empty());
+}
+
+void test_deque_thief_steals_in_fifo_order() {
+	WorkStealingDeque<int> deque{4};
+	deque.try_push(1);
+	deque.try_push(2);
+	deque.try_push(3);
+	ASSERT_EQUAL(1, deque.try_steal().value());
+	ASSERT_EQUAL(2, deque.try_steal().value());
+	ASSERT_EQUAL(3, deque.try_pop().value());
+	ASSERT(!deque.try_steal());
+}
+
+void test_full_deque_rejects_push() {
+	WorkStealingDeque<int> deque{2};
+	ASSERT(deque.try_push(1));
+	ASSERT(deque.try_push(2));
+	ASSERT(!deque.try_push(3));
+	ASSERT_EQUAL(2, deque.size());
+}
+
+void test_deque_wraps_around() {
+	WorkStealingDeque<int> deque{4};
+	std::vector<int> stolen{}, expected(20);
+	std::iota(std::begin(expected), std::end(expected), 0);
+	for (int i = 0; i < 20; ++i) {
+		deque.try_push(i);
+		if (i % 2) 2_times([&]{ stolen.push_back(deque.try_steal().value()); });
+	}
+	ASSERT_EQUAL(expected, stolen);
+}
+
+void test_deque_hands_out_every_element_exactly_once() {
+	int const nOfElements = 100000;
+	WorkStealingDeque<int> deque{64};
+	std::atomic<bool> done{false};
+
+	auto thief = [&]{
+		std::vector<int> stolen{};
+		while (!done || !deque.empty()) {
+			if (auto ele = deque.try_steal()) stolen.push_back(*ele);
+		}
+		return stolen;
+	};
+	std::vector<std::future<std::vector<int>>> thieves{};
+	3_times([&]{ thieves.push_back(std::async(std::launch::async, thief)); });
+
+	std::vector<int> taken{};
+	for (int i = 0; i < nOfElements; ++i) {
+		while (!deque.try_push(i)) {
+			if (auto ele = deque.try_pop()) taken.push_back(*ele);
+		}
+		if (i % 3 == 0) {
+			if (auto ele = deque.try_pop()) taken.push_back(*ele);
+		}
+	}
+	while (auto ele = deque.try_pop()) taken.push_back(*ele);
+	done = true;
+
+	for (auto & part : thieves) {
+		auto stolen = part.get();
+		taken.insert(std::end(taken), std::begin(stolen), std::end(stolen));
+	}
+	std::sort(std::begin(taken), std::end(taken));
+	std::vector<int> expected(nOfElements);
+	std::iota(std::begin(expected), std::end(expected), 0);
+	ASSERT_EQUAL(expected, taken);
+}
+
+cute::suite make_suite_work_stealing_deque_suite() {
+	cute::suite s;
+	s.push_back(CUTE(test_deque_constructor_for_capacity_zero_throws));
+	s.push_back(CUTE(test_deque_capacity_is_rounded_up_to_power_of_two));
+	s.push_back(CUTE(test_new_deque_is_empty));
+	s.push_back(CUTE(test_deque_owner_pops_in_lifo_order));
+	s.push_back(CUTE(test_deque_thief_steals_in_fifo_order));
+	s.push_back(CUTE(test_full_deque_rejects_push));
+	s.push_back(CUTE(test_deque_wraps_around));
+	s.push_back(CUTE(test_deque_hands_out_every_element_exactly_once));
+	return s;
+}
@@ -0,0 +1,8 @@
+#ifndef WORK_STEALING_DEQUE_SUITE_H_
+#define WORK_STEALING_DEQUE_SUITE_H_
+
+#include "cute_suite.h"
+
+extern cute::suite make_suite_work_stealing_deque_suite();
+
+#endif
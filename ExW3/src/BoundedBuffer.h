@@ -1,42 +1,46 @@
 #ifndef SRC_BOUNDEDBUFFER_H_
 #define SRC_BOUNDEDBUFFER_H_
 
+#include "CapacityPolicy.h"
+
 #include <boost/operators.hpp>
 
 #include <array>
 #include <utility>
 #include <stdexcept>
 
-template <size_t N, typename size_type=size_t>
+template <size_t N, typename size_type=size_t, typename CapacityPolicy=ModuloCapacity>
 struct RingN :
-		private boost::equality_comparable<RingN<N, size_type>>,
-		private boost::addable<RingN<N, size_type>>,
-		private boost::subtractable<RingN<N, size_type>>,
-		private boost::incrementable<RingN<N, size_type>> {
-	RingN(size_type x=0ul) : val_{static_cast<size_type>(x % N)} { }
+		private boost::equality_comparable<RingN<N, size_type, CapacityPolicy>>,
+		private boost::addable<RingN<N, size_type, CapacityPolicy>>,
+		private boost::subtractable<RingN<N, size_type, CapacityPolicy>>,
+		private boost::incrementable<RingN<N, size_type, CapacityPolicy>> {
+	RingN(size_type x=0ul) : val_{mod(x)} { }
 	size_type operator*() const { return val_; }
 	bool operator==(RingN const & r) const { return val_ == r.val_; }
 	RingN operator+=(RingN const & r) {
-		val_ = (val_ + r.val_) % N;
+		val_ = mod(val_ + r.val_);
 		return *this;
 	}
 	RingN operator-=(RingN const & r) {
-		if (val_ < r.val_) val_ = N + (r.val_ % N) - 1;
-		val_ = (val_ - r.val_) % N;
+		if (val_ < r.val_) val_ = N + mod(r.val_) - 1;
+		val_ = mod(val_ - r.val_);
 		return *this;
 	}
 	friend RingN operator++(RingN & r) { return r += 1; }
 	friend RingN operator--(RingN & r) { return r -= 1; }
 private:
 	size_type val_;
+
+	static size_type mod(size_type const x) { return CapacityPolicy::index(x, static_cast<size_type>(N)); }
 };
 
-template <typename size_type>
-struct RingN<0, size_type> :
-		private boost::equality_comparable<RingN<0, size_type>>,
-		private boost::addable<RingN<0, size_type>>,
-		private boost::subtractable<RingN<0, size_type>>,
-		private boost::incrementable<RingN<0, size_type>> {
+template <typename size_type, typename CapacityPolicy>
+struct RingN<0, size_type, CapacityPolicy> :
+		private boost::equality_comparable<RingN<0, size_type, CapacityPolicy>>,
+		private boost::addable<RingN<0, size_type, CapacityPolicy>>,
+		private boost::subtractable<RingN<0, size_type, CapacityPolicy>>,
+		private boost::incrementable<RingN<0, size_type, CapacityPolicy>> {
 	RingN(size_type x = 0ul) { }
 	size_type operator*() const { return 0; }
 	bool operator==(RingN const & r) const { return 0 == *r; }
@@ -48,14 +52,16 @@ private:
 };
 
 
-template <typename T, size_t N>
+template <typename T, size_t N, typename CapacityPolicy=ModuloCapacity>
 struct BoundedBuffer {
-	using container_type = std::array<T, N>;
+	static constexpr size_t capacity{CapacityPolicy::capacity(N)};
+
+	using container_type = std::array<T, capacity>;
 	using value_type = typename container_type::value_type;
 	using reference = typename container_type::reference;
 	using const_reference = typename container_type::const_reference;
 	using size_type = typename container_type::size_type;
-	using index_type = RingN<N, size_type>;
+	using index_type = RingN<capacity, size_type, CapacityPolicy>;
 
 	BoundedBuffer() = default;
 	BoundedBuffer(BoundedBuffer const & other) :
@@ -79,7 +85,7 @@ struct BoundedBuffer {
 	}
 
 	bool empty() const noexcept { return count == 0; }
-	bool full() const noexcept { return count == N; }
+	bool full() const noexcept { return count == capacity; }
 	size_type size() const noexcept { return count; }
 
 	reference front() {
@@ -135,15 +141,15 @@ struct BoundedBuffer {
 	}
 
 	template<typename Tm>
-	static BoundedBuffer<T, N> make_buffer(Tm && ele) {
-		BoundedBuffer<T, N> buffer{};
+	static BoundedBuffer make_buffer(Tm && ele) {
+		BoundedBuffer buffer{};
 		buffer.push(std::forward<Tm>(ele));
 		return buffer;
 	}
 
 	template<typename... ELES>
-	static BoundedBuffer<T, N> make_buffer(ELES && ...eles) {
-		BoundedBuffer<T, N> buffer{};
+	static BoundedBuffer make_buffer(ELES && ...eles) {
+		BoundedBuffer buffer{};
 		buffer.push_many(std::forward<decltype(eles)>(eles)...);
 		return buffer;
 	}
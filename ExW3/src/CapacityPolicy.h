@@ -0,0 +1,44 @@
+#ifndef SRC_CAPACITYPOLICY_H_
+#define SRC_CAPACITYPOLICY_H_
+
+/*
+ * A capacity policy decides how a ring buffer maps its free-running index onto a slot.
+ * - ModuloCapacity keeps the requested capacity and uses %, i.e. an integer division.
+ * - PowerOfTwoCapacity rounds the capacity up to the next power of two and uses a bit mask.
+ * - ExactPowerOfTwoCapacity requires a power of two capacity and uses a bit mask.
+ * A power of two capacity divides 2^64, hence with the mask policies the free-running
+ * 64-bit counters stay correct even when they wrap around.
+ */
+
+#include <limits>
+#include <stdexcept>
+
+struct ModuloCapacity {
+	template<typename I>
+	static constexpr I capacity(I const requested) { return requested; }
+	template<typename I>
+	static constexpr I index(I const i, I const capacity) noexcept { return i % capacity; }
+};
+
+struct PowerOfTwoCapacity {
+	template<typename I>
+	static constexpr I capacity(I const requested) {
+		I capacity{1};
+		for (; capacity < requested; capacity <<= 1) {
+			if (capacity > std::numeric_limits<I>::max() / 2) throw std::length_error{"capacity too large"};
+		}
+		return requested ? capacity : 0;
+	}
+	template<typename I>
+	static constexpr I index(I const i, I const capacity) noexcept { return i & (capacity - 1); }
+};
+
+struct ExactPowerOfTwoCapacity : PowerOfTwoCapacity {
+	template<typename I>
+	static constexpr I capacity(I const requested) {
+		if (!(requested > 0) || (requested & (requested - 1))) throw std::invalid_argument{"capacity must be a power of two"};
+		return requested;
+	}
+};
+
+#endif /* SRC_CAPACITYPOLICY_H_ */
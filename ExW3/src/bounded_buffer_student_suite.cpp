@@ -61,6 +61,41 @@ void testZeroNDecrement() {
 	ASSERT_EQUAL(decltype(zero){0}, zero);
 }
 
+void testPowerOfTwoAddOverflow() {
+	RingN<8, size_t, ExactPowerOfTwoCapacity> three{6};
+	three += 5;
+	ASSERT_EQUAL(decltype(three){3}, three);
+}
+
+void testPowerOfTwoDecrementUnderflow() {
+	RingN<4, size_t, ExactPowerOfTwoCapacity> three{0};
+	--three;
+	ASSERT_EQUAL(decltype(three){3}, three);
+}
+
+void testPowerOfTwoBufferRoundsCapacityUp() {
+	ASSERT_EQUAL(8, (BoundedBuffer<int, 5, PowerOfTwoCapacity>::capacity));
+}
+
+void testPowerOfTwoBufferIsFullAtRoundedCapacity() {
+	BoundedBuffer<int, 3, PowerOfTwoCapacity> buffer{};
+	buffer.push_many(1, 2, 3);
+	ASSERT(!buffer.full());
+	buffer.push(4);
+	ASSERT(buffer.full());
+}
+
+void testPowerOfTwoBufferWrapsAround() {
+	BoundedBuffer<int, 4, ExactPowerOfTwoCapacity> buffer{};
+	buffer.push_many(1, 2, 3);
+	for (int i = 4; i <= 10; ++i) {
+		ASSERT_EQUAL(i - 3, buffer.front());
+		buffer.pop();
+		buffer.push(i);
+	}
+	ASSERT_EQUAL(10, buffer.back());
+}
+
 cute::suite make_suite_bounded_buffer_student_suite() {
 	cute::suite s;
 	s.push_back(CUTE(testValueCtorWithLargeInput));
@@ -73,6 +108,11 @@ cute::suite make_suite_bounded_buffer_student_suite() {
 	s.push_back(CUTE(testZeroN));
 	s.push_back(CUTE(testZeroNIncrement));
 	s.push_back(CUTE(testZeroNDecrement));
+	s.push_back(CUTE(testPowerOfTwoAddOverflow));
+	s.push_back(CUTE(testPowerOfTwoDecrementUnderflow));
+	s.push_back(CUTE(testPowerOfTwoBufferRoundsCapacityUp));
+	s.push_back(CUTE(testPowerOfTwoBufferIsFullAtRoundedCapacity));
+	s.push_back(CUTE(testPowerOfTwoBufferWrapsAround));
 	return s;
 }
 
@@ -1,15 +1,29 @@
 #ifndef SRC_BOUNDEDBUFFER_H_
 #define SRC_BOUNDEDBUFFER_H_
 
+/*
+ * The ring is obtained from Allocator through std::allocator_traits, so it is aligned for T
+ * and can live in an arena: pmr::BoundedBuffer takes a std::pmr::memory_resource.
+ * Copies, moves, assignment and swap treat the allocator like the standard containers do.
+ */
+
+#include "CapacityPolicy.h"
+
 #include <boost/operators.hpp>
 
 #include <iostream>
 #include <memory>
+#include <memory_resource>
 #include <stdexcept>
+#include <type_traits>
 #include <utility>
 
-template <typename T>
+template <typename T, typename CapacityPolicy=ModuloCapacity, typename Allocator=std::allocator<T>>
 struct BoundedBuffer {
+	using alloc_traits = std::allocator_traits<Allocator>;
+	static_assert(std::is_same<typename alloc_traits::value_type, T>::value, "Allocator::value_type must be T");
+	static_assert(std::is_same<typename alloc_traits::pointer, T *>::value, "fancy pointers are not supported");
+
 	template<typename Container, typename Ref> struct BBIterator;
 
 	using value_type = T;
@@ -18,36 +32,55 @@ struct BoundedBuffer {
 	using size_type = size_t;
 	using iterator = BBIterator<BoundedBuffer, reference>;
 	using const_iterator = BBIterator<const BoundedBuffer, const_reference>;
-	using memory_type = std::unique_ptr<char[]>;
+	using allocator_type = Allocator;
 
-	explicit BoundedBuffer(size_type capacity) : capacity_ {capacity}, container_ {newMemory()} {
+	explicit BoundedBuffer(size_type capacity, allocator_type const & allocator = allocator_type{}) :
+			capacity_ {CapacityPolicy::capacity(capacity)}, container_ {allocator, capacity_} {
 		if (capacity == 0) throw std::invalid_argument{"capacity must be > 0"};
 	}
 
 	~BoundedBuffer() { clear(); }
 
-	BoundedBuffer(BoundedBuffer const & rhs) : capacity_{rhs.capacity_}, container_{newMemory()} {
+	BoundedBuffer(BoundedBuffer const & rhs) :
+			BoundedBuffer{rhs, alloc_traits::select_on_container_copy_construction(rhs.get_allocator())} {}
+	BoundedBuffer(BoundedBuffer const & rhs, allocator_type const & allocator) : capacity_{rhs.capacity_}, container_{allocator, capacity_} {
 		copyFromBoundedBuffer(rhs);
 	}
-	BoundedBuffer(BoundedBuffer && rhs) { swap(rhs); }
+	BoundedBuffer(BoundedBuffer && rhs) : container_{rhs.get_allocator(), 0} { swap(rhs); }
+	BoundedBuffer(BoundedBuffer && rhs, allocator_type const & allocator) : capacity_{rhs.capacity_}, container_{allocator, capacity_} {
+		if (allocator == rhs.get_allocator()) {
+			swap(rhs);
+			return;
+		}
+		for (; !rhs.empty(); rhs.pop()) push(std::move(rhs.front()));
+	}
 
 	BoundedBuffer & operator=(BoundedBuffer const & rhs) {
 		if (&rhs == this) return *this;
 
-		auto tmp{rhs};
-		tmp.swap(*this);
+		constexpr bool propagate{alloc_traits::propagate_on_container_copy_assignment::value};
+		BoundedBuffer tmp{rhs, propagate ? rhs.get_allocator() : get_allocator()};
+		swapWith<propagate>(tmp);
 		return *this;
 	}
 	BoundedBuffer & operator=(BoundedBuffer && rhs) {
 		if (&rhs == this) return *this;
 
-		swap(rhs);
+		constexpr bool propagate{alloc_traits::propagate_on_container_move_assignment::value};
+		if (propagate || get_allocator() == rhs.get_allocator()) {
+			swapWith<propagate>(rhs);
+		} else {
+			BoundedBuffer tmp{std::move(rhs), get_allocator()};
+			swapWith<false>(tmp);
+		}
 		return *this;
 	}
 
 	bool empty() const noexcept { return size_ == 0; }
 	bool full() const noexcept { return size_ == capacity_; }
 	size_type size() const noexcept { return size_; }
+	size_type capacity() const noexcept { return capacity_; }
+	allocator_type get_allocator() const noexcept { return container_.allocator; }
 
 	reference front() {
 		throwIfEmpty();
@@ -85,13 +118,7 @@ struct BoundedBuffer {
 		++index_;
 	}
 
-	void swap(BoundedBuffer & b) {
-		using std::swap;
-		swap(index_, b.index_);
-		swap(size_, b.size_);
-		swap(capacity_, b.capacity_);
-		swap(container_, b.container_);
-	}
+	void swap(BoundedBuffer & b) { swapWith<alloc_traits::propagate_on_container_swap::value>(b); }
 
 	iterator begin() { return iterator{this}; }
 	iterator end() { return iterator{this, size_}; }
@@ -103,8 +130,8 @@ struct BoundedBuffer {
 	const_iterator cend() const { return const_iterator{this, size_}; }
 
 	template<typename... ELES>
-	static BoundedBuffer<T> make_buffer(ELES && ...eles) {
-		BoundedBuffer<T> buffer{sizeof...(ELES)};
+	static BoundedBuffer make_buffer(ELES && ...eles) {
+		BoundedBuffer buffer{sizeof...(ELES)};
 		buffer.push_many(std::forward<decltype(eles)>(eles)...);
 		return buffer;
 	}
@@ -121,25 +148,54 @@ struct BoundedBuffer {
 	void clear() { while(!empty()) pop(); }
 
 private:
+	// the uninitialized ring together with the allocator it has to be given back to
+	struct Storage {
+		Storage(allocator_type const & allocator, size_type capacity) :
+				allocator{allocator}, capacity{capacity}, memory{capacity ? alloc_traits::allocate(this->allocator, capacity) : nullptr} {}
+		~Storage() { if (memory) alloc_traits::deallocate(allocator, memory, capacity); }
+
+		Storage(Storage const &) = delete;
+		Storage & operator=(Storage const &) = delete;
+
+		template<bool PropagateAllocator>
+		void swap(Storage & rhs) noexcept {
+			using std::swap;
+			if constexpr (PropagateAllocator) swap(allocator, rhs.allocator);
+			swap(capacity, rhs.capacity);
+			swap(memory, rhs.memory);
+		}
+
+		[[no_unique_address]] allocator_type allocator;
+		size_type capacity;
+		T * memory;
+	};
+
 	size_type index_{0};
 	size_type size_{0};
 	size_type capacity_{0};
-	memory_type container_;
+	Storage container_;
+
+	template<bool PropagateAllocator>
+	void swapWith(BoundedBuffer & b) {
+		using std::swap;
+		swap(index_, b.index_);
+		swap(size_, b.size_);
+		swap(capacity_, b.capacity_);
+		container_.template swap<PropagateAllocator>(b.container_);
+	}
 
 
 	void throwIfEmpty() const { if (empty()) throw std::logic_error{"empty container"}; }
 	void throwIfFull() const { if (full()) throw std::logic_error{"full container"}; }
 
-	size_type calcMod(size_type const & i) const noexcept { return i % capacity_; }
+	size_type calcMod(size_type const & i) const noexcept { return CapacityPolicy::index(i, capacity_); }
 	size_type backOffset() const noexcept { return size_ - 1; }
 
 	size_type positionToAdd() noexcept { return calcMod(index_ + size_); }
 
 	void copyFromBoundedBuffer(BoundedBuffer const & rhs) { for (auto const & e : rhs) push(e); }
 
-	char * newMemory() const { return new char[sizeof(T) * capacity_]; }
-	T* elements() const { return elements(container_); }
-	T* elements(memory_type const & container) const { return reinterpret_cast<T*>(container.get()); }
+	T* elements() const { return container_.memory; }
 
 public:
 	template<typename Container, typename Ref>
@@ -222,4 +278,9 @@ public:
 	};
 };
 
+namespace pmr {
+template <typename T, typename CapacityPolicy=ModuloCapacity>
+using BoundedBuffer = ::BoundedBuffer<T, CapacityPolicy, std::pmr::polymorphic_allocator<T>>;
+}
+
 #endif /* SRC_BOUNDEDBUFFER_H_ */
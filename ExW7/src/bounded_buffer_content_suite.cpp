@@ -241,6 +241,31 @@ void test_buffer_after_swap_argument_has_this_content() {
 	ASSERT_EQUAL(expectedValues, frontValues);
 }
 
+void test_power_of_two_buffer_rounds_capacity_up() {
+	BoundedBuffer<int, PowerOfTwoCapacity> buffer { 5 };
+	ASSERT_EQUAL(8, buffer.capacity());
+}
+
+void test_exact_power_of_two_buffer_rejects_other_capacities() {
+	using Buffer = BoundedBuffer<int, ExactPowerOfTwoCapacity>;
+	ASSERT_THROWS(Buffer buffer { 6 }, std::invalid_argument);
+}
+
+void test_power_of_two_buffer_wrap_around_behavior_front() {
+	BoundedBuffer<int, ExactPowerOfTwoCapacity> buffer { 4 };
+	std::vector<int> frontValues { }, expectedValues { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10 };
+	buffer.push(1);
+	buffer.push(2);
+	buffer.push(3);
+	for (int i = 4; i <= 10; ++i) {
+		frontValues.push_back(buffer.front());
+		buffer.pop();
+		buffer.push(i);
+	}
+	3_times([&]() {frontValues.push_back(buffer.front()); buffer.pop();});
+	ASSERT_EQUAL(expectedValues, frontValues);
+}
+
 cute::suite make_suite_bounded_buffer_content_suite() {
 	cute::suite s;
 	s.push_back(CUTE(test_buffer_is_not_empty_after_push_rvalue));
@@ -266,6 +291,9 @@ cute::suite make_suite_bounded_buffer_content_suite() {
 	s.push_back(CUTE(test_buffer_wrap_around_behavior_back));
 	s.push_back(CUTE(test_buffer_after_swap_this_has_argument_content));
 	s.push_back(CUTE(test_buffer_after_swap_argument_has_this_content));
+	s.push_back(CUTE(test_power_of_two_buffer_rounds_capacity_up));
+	s.push_back(CUTE(test_exact_power_of_two_buffer_rejects_other_capacities));
+	s.push_back(CUTE(test_power_of_two_buffer_wrap_around_behavior_front));
 	return s;
 }
 
@@ -2,6 +2,8 @@
 #include "cute.h"
 #include "BoundedBuffer.h"
 #include "times_literal.hpp"
+#include <cstdint>
+#include <memory_resource>
 
 
 struct AllocationTracker {
@@ -183,6 +185,70 @@ void test_copy_only_initialized_elements_in_copy_assignment(){
 	ASSERT_EQUAL(50, CopyCounter::copy_counter);
 }
 
+struct CountingResource : std::pmr::memory_resource {
+	std::size_t allocations{0};
+	std::size_t deallocations{0};
+
+private:
+	void * do_allocate(std::size_t size, std::size_t alignment) override {
+		++allocations;
+		return std::pmr::new_delete_resource()->allocate(size, alignment);
+	}
+	void do_deallocate(void * memory, std::size_t size, std::size_t alignment) override {
+		++deallocations;
+		std::pmr::new_delete_resource()->deallocate(memory, size, alignment);
+	}
+	bool do_is_equal(std::pmr::memory_resource const & other) const noexcept override { return this == &other; }
+};
+
+void test_pmr_buffer_takes_its_ring_from_the_memory_resource() {
+	CountingResource resource{};
+	{
+		pmr::BoundedBuffer<int> buffer{4, &resource};
+		buffer.push(1);
+		ASSERT_EQUAL(1, resource.allocations);
+	}
+	ASSERT_EQUAL(1, resource.deallocations);
+}
+
+void test_moved_pmr_buffer_keeps_its_memory_resource() {
+	CountingResource resource{};
+	pmr::BoundedBuffer<int> buffer{4, &resource};
+	buffer.push(1);
+	pmr::BoundedBuffer<int> moved{std::move(buffer)};
+	ASSERT_EQUAL(&resource, moved.get_allocator().resource());
+	ASSERT_EQUAL(1, resource.allocations);
+	ASSERT_EQUAL(1, moved.front());
+}
+
+void test_move_assignment_between_memory_resources_moves_the_elements() {
+	CountingResource resource{}, other{};
+	pmr::BoundedBuffer<int> buffer{4, &resource}, moved{2, &other};
+	buffer.push(1);
+	buffer.push(2);
+	moved = std::move(buffer);
+	ASSERT_EQUAL(&other, moved.get_allocator().resource());
+	ASSERT_EQUAL(2, moved.size());
+	ASSERT_EQUAL(1, moved.front());
+	ASSERT_EQUAL(2, moved.back());
+}
+
+struct alignas(64) OverAligned {
+	OverAligned() { misaligned += reinterpret_cast<std::uintptr_t>(this) % alignof(OverAligned) != 0; }
+	OverAligned(OverAligned const &) : OverAligned{} {}
+	static unsigned misaligned;
+};
+unsigned OverAligned::misaligned{0};
+
+void test_over_aligned_elements_are_constructed_aligned() {
+	OverAligned::misaligned = 0;
+	BoundedBuffer<OverAligned> buffer{3};
+	3_times([&](){
+		buffer.push(OverAligned{});
+	});
+	ASSERT_EQUAL(0, OverAligned::misaligned);
+}
+
 
 cute::suite make_suite_bounded_buffer_heap_memory_suite() {
 	cute::suite s;
@@ -197,6 +263,10 @@ cute::suite make_suite_bounded_buffer_heap_memory_suite() {
 	s.push_back(CUTE(test_move_constructor_does_not_allocate_a_new_buffer));
 	s.push_back(CUTE(test_copy_assignment_one_additional_allocation));
 	s.push_back(CUTE(test_move_assignment_no_additional_allocation));
+	s.push_back(CUTE(test_pmr_buffer_takes_its_ring_from_the_memory_resource));
+	s.push_back(CUTE(test_moved_pmr_buffer_keeps_its_memory_resource));
+	s.push_back(CUTE(test_move_assignment_between_memory_resources_moves_the_elements));
+	s.push_back(CUTE(test_over_aligned_elements_are_constructed_aligned));
 	return s;
 }
 